@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/alloc.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using namespace t9_result;
+
+// 1リクエストで確保する一時オブジェクト
+struct Header {
+  std::uint64_t m_key;
+  std::uint64_t m_value;
+};
+
+struct Request {
+  Header* m_headers[16];
+  std::size_t m_header_count;
+  std::byte* m_body;
+};
+
+constexpr std::size_t kHeaderCount = 16;
+constexpr std::size_t kBodySize = 512;
+
+// new/delete で一時オブジェクトを確保する
+void BM_RequestNew(benchmark::State& state) {
+  std::uint64_t id = 0;
+  for (auto _ : state) {
+    auto request = try_new<Request>().unwrap();
+    for (std::size_t i = 0; i < kHeaderCount; ++i) {
+      request->m_headers[i] = try_new<Header>(Header{i, id}).unwrap();
+    }
+    request->m_header_count = kHeaderCount;
+    request->m_body = try_allocate<std::byte>(kBodySize).unwrap();
+    benchmark::DoNotOptimize(request);
+
+    deallocate(request->m_body);
+    for (std::size_t i = 0; i < kHeaderCount; ++i) {
+      delete request->m_headers[i];
+    }
+    delete request;
+    ++id;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RequestNew);
+
+// アリーナで一時オブジェクトを確保し、リクエストごとにリセットする
+void BM_RequestArena(benchmark::State& state) {
+  auto arena = Arena::create(16 * 1024).unwrap();
+  std::uint64_t id = 0;
+  for (auto _ : state) {
+    auto request = arena.construct<Request>().unwrap();
+    for (std::size_t i = 0; i < kHeaderCount; ++i) {
+      request->m_headers[i] = arena.construct<Header>(Header{i, id}).unwrap();
+    }
+    request->m_header_count = kHeaderCount;
+    request->m_body = arena.allocate(kBodySize).unwrap().data();
+    benchmark::DoNotOptimize(request);
+
+    arena.reset();
+    ++id;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RequestArena);
+
+}  // namespace
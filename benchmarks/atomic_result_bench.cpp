@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/atomic_result.h>
+
+#include <cstdint>
+#include <mutex>
+
+namespace {
+
+using namespace t9_result;
+
+enum class Health : std::uint32_t {
+  Degraded = 1,
+  Down,
+};
+
+struct Snapshot {
+  std::uint64_t m_version;
+  std::uint64_t m_flags;
+};
+
+// 1スレッドが書き込み、残りのスレッドが読み込む
+constexpr int kThreads = 65;
+
+template <typename T, typename E>
+class MutexResult {
+ private:
+  mutable std::mutex m_mutex;
+  Result<T, E> m_value;
+
+ public:
+  explicit MutexResult(Result<T, E> initial) : m_value(std::move(initial)) {}
+
+  void store(const Result<T, E>& result) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_value = result;
+  }
+
+  Result<T, E> load() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_value;
+  }
+};
+
+template <typename Cell, typename MakeValue>
+void run(benchmark::State& state, Cell& cell, MakeValue make_value) {
+  std::uint64_t version = 0;
+  for (auto _ : state) {
+    if (state.thread_index() == 0) {
+      cell.store(make_value(++version));
+    } else {
+      auto r = cell.load();
+      benchmark::DoNotOptimize(r);
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+Result<std::uint32_t, Health> small_value(std::uint64_t version) {
+  if (version % 16 == 0) {
+    return make_err(Health::Degraded);
+  }
+  return make_ok(static_cast<std::uint32_t>(version));
+}
+
+Result<Snapshot, Health> large_value(std::uint64_t version) {
+  if (version % 16 == 0) {
+    return make_err(Health::Degraded);
+  }
+  return make_ok(Snapshot{version, version});
+}
+
+// 8バイトに収まる Result を mutex で保護
+void BM_MutexSmall(benchmark::State& state) {
+  static MutexResult<std::uint32_t, Health> cell(small_value(1));
+  run(state, cell, small_value);
+}
+BENCHMARK(BM_MutexSmall)->Threads(kThreads)->UseRealTime();
+
+// 8バイトに収まる Result をロックフリーで公開
+void BM_AtomicSmall(benchmark::State& state) {
+  static AtomicResult<std::uint32_t, Health> cell(small_value(1));
+  run(state, cell, small_value);
+}
+BENCHMARK(BM_AtomicSmall)->Threads(kThreads)->UseRealTime();
+
+// 8バイトを超える Result を mutex で保護
+void BM_MutexLarge(benchmark::State& state) {
+  static MutexResult<Snapshot, Health> cell(large_value(1));
+  run(state, cell, large_value);
+}
+BENCHMARK(BM_MutexLarge)->Threads(kThreads)->UseRealTime();
+
+// 8バイトを超える Result をシーケンスロックで公開
+void BM_AtomicLarge(benchmark::State& state) {
+  static AtomicResult<Snapshot, Health> cell(large_value(1));
+  run(state, cell, large_value);
+}
+BENCHMARK(BM_AtomicLarge)->Threads(kThreads)->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/backtrace.h>
+
+#include <cstdint>
+
+namespace {
+
+using namespace t9_result;
+
+enum class IoError {
+  NotFound,
+};
+
+// 呼び出しの深さを変えて失敗を返す
+template <typename E>
+__attribute__((noinline)) Result<std::uint64_t, E> fail(int depth) {
+  if (depth == 0) {
+    return make_err(IoError::NotFound);
+  }
+  auto result = fail<E>(depth - 1);
+  asm volatile("" ::: "memory");
+  return result;
+}
+
+// バックトレースを持たない失敗値
+void BM_ErrPlain(benchmark::State& state) {
+  int depth = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    auto r = fail<IoError>(depth);
+    benchmark::DoNotOptimize(r);
+  }
+}
+BENCHMARK(BM_ErrPlain)->Arg(4)->Arg(32);
+
+// Traced で記録を無効にした場合
+void BM_ErrTracedOff(benchmark::State& state) {
+  int depth = static_cast<int>(state.range(0));
+  set_backtrace_enabled(false);
+  for (auto _ : state) {
+    auto r = fail<Traced<IoError>>(depth);
+    benchmark::DoNotOptimize(r);
+  }
+  set_backtrace_enabled(true);
+}
+BENCHMARK(BM_ErrTracedOff)->Arg(4)->Arg(32);
+
+// Traced で記録した場合（最大 kMaxFrames フレーム）
+void BM_ErrTracedOn(benchmark::State& state) {
+  int depth = static_cast<int>(state.range(0));
+  set_backtrace_enabled(true);
+  for (auto _ : state) {
+    auto r = fail<Traced<IoError>>(depth);
+    benchmark::DoNotOptimize(r);
+  }
+}
+BENCHMARK(BM_ErrTracedOn)->Arg(4)->Arg(32);
+
+// 記録後のシンボル解決（表示時のみ発生するコスト）
+void BM_Symbolize(benchmark::State& state) {
+  auto r = fail<Traced<IoError>>(4);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(r.ref_err().m_backtrace.to_string());
+  }
+}
+BENCHMARK(BM_Symbolize);
+
+}  // namespace
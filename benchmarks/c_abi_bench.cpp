@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/c_abi.h>
+
+#include <cstdint>
+
+namespace {
+
+using namespace t9_result;
+
+enum class Code : std::int32_t {
+  Odd = 1,
+};
+
+// 境界を越える呼び出しを模擬するため、すべてインライン展開を禁止する
+
+// 従来の int 戻り値と出力引数
+extern "C" __attribute__((noinline)) int raw_half(std::int64_t x,
+                                                  std::int64_t* out) {
+  if (x & 1) {
+    return 1;
+  }
+  *out = x / 2;
+  return 0;
+}
+
+// t9_result_i64 を値で返す
+extern "C" __attribute__((noinline)) t9_result_i64 c_half(std::int64_t x) {
+  Result<std::int64_t, Code> result =
+      (x & 1) ? Result<std::int64_t, Code>(make_err(Code::Odd))
+              : Result<std::int64_t, Code>(make_ok(x / 2));
+  return to_c(result);
+}
+
+// C++ の Result をそのまま返す
+__attribute__((noinline)) Result<std::int64_t, Code> cpp_half(
+    std::int64_t x) {
+  if (x & 1) {
+    return make_err(Code::Odd);
+  }
+  return make_ok(x / 2);
+}
+
+void BM_RawInt(benchmark::State& state) {
+  std::int64_t x = 0;
+  std::int64_t sum = 0;
+  for (auto _ : state) {
+    std::int64_t value;
+    if (raw_half(x++, &value) == 0) {
+      sum += value;
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RawInt);
+
+void BM_CStruct(benchmark::State& state) {
+  std::int64_t x = 0;
+  std::int64_t sum = 0;
+  for (auto _ : state) {
+    t9_result_i64 result = c_half(x++);
+    if (T9_IS_OK(result)) {
+      sum += result.value;
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CStruct);
+
+// C の構造体を受け取り Result に戻す（C++ 側で受ける場合）
+void BM_CStructFromC(benchmark::State& state) {
+  std::int64_t x = 0;
+  std::int64_t sum = 0;
+  for (auto _ : state) {
+    auto result = from_c<std::int64_t, Code>(c_half(x++));
+    if (result.is_ok()) {
+      sum += result.unchecked_ok();
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CStructFromC);
+
+void BM_CppResult(benchmark::State& state) {
+  std::int64_t x = 0;
+  std::int64_t sum = 0;
+  for (auto _ : state) {
+    auto result = cpp_half(x++);
+    if (result.is_ok()) {
+      sum += result.unchecked_ok();
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CppResult);
+
+}  // namespace
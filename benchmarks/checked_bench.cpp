@@ -0,0 +1,175 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/checked.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+// 請求額の明細を模擬した値（オーバーフローしない範囲）
+template <typename T>
+std::vector<T> make_amounts(std::size_t n, std::uint32_t seed) {
+  std::vector<T> values(n);
+  std::uint32_t x = seed;
+  for (auto& value : values) {
+    x = x * 1664525u + 1013904223u;
+    // 16ビットの型は積がオーバーフローしないよう 0..127 にする
+    value = static_cast<T>(x >> (sizeof(T) < 4 ? 25 : 20));
+  }
+  return values;
+}
+
+// 要素ごとに __builtin_*_overflow で分岐する従来のループ
+template <typename T>
+__attribute__((noinline)) bool scalar_add(const T* a, const T* b, T* out,
+                                          std::size_t n, std::size_t* index) {
+  for (std::size_t i = 0; i < n; ++i) {
+    if (__builtin_add_overflow(a[i], b[i], &out[i])) {
+      *index = i;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+__attribute__((noinline)) bool scalar_mul(const T* a, const T* b, T* out,
+                                          std::size_t n, std::size_t* index) {
+  for (std::size_t i = 0; i < n; ++i) {
+    if (__builtin_mul_overflow(a[i], b[i], &out[i])) {
+      *index = i;
+      return false;
+    }
+  }
+  return true;
+}
+
+// 要素ごとに checked_add() の Result で分岐するループ
+template <typename T>
+__attribute__((noinline)) Result<void, BatchError> result_add(
+    const T* a, const T* b, T* out, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    auto r = checked_add(a[i], b[i]);
+    if (r.is_err()) {
+      return make_err(BatchError{r.unchecked_err(), i});
+    }
+    out[i] = r.unchecked_ok();
+  }
+  return make_ok();
+}
+
+template <typename T>
+void BM_AddScalar(benchmark::State& state) {
+  auto n = static_cast<std::size_t>(state.range(0));
+  auto a = make_amounts<T>(n, 1);
+  auto b = make_amounts<T>(n, 2);
+  std::vector<T> out(n);
+  for (auto _ : state) {
+    std::size_t index = 0;
+    benchmark::DoNotOptimize(
+        scalar_add(a.data(), b.data(), out.data(), n, &index));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+void BM_AddResult(benchmark::State& state) {
+  auto n = static_cast<std::size_t>(state.range(0));
+  auto a = make_amounts<T>(n, 1);
+  auto b = make_amounts<T>(n, 2);
+  std::vector<T> out(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(result_add(a.data(), b.data(), out.data(), n));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+void BM_AddBatch(benchmark::State& state) {
+  auto n = static_cast<std::size_t>(state.range(0));
+  auto a = make_amounts<T>(n, 1);
+  auto b = make_amounts<T>(n, 2);
+  std::vector<T> out(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(checked_add_n(a.data(), b.data(), out.data(), n));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+void BM_MulScalar(benchmark::State& state) {
+  auto n = static_cast<std::size_t>(state.range(0));
+  auto a = make_amounts<T>(n, 1);
+  auto b = make_amounts<T>(n, 2);
+  std::vector<T> out(n);
+  for (auto _ : state) {
+    std::size_t index = 0;
+    benchmark::DoNotOptimize(
+        scalar_mul(a.data(), b.data(), out.data(), n, &index));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename T>
+void BM_MulBatch(benchmark::State& state) {
+  auto n = static_cast<std::size_t>(state.range(0));
+  auto a = make_amounts<T>(n, 1);
+  auto b = make_amounts<T>(n, 2);
+  std::vector<T> out(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(checked_mul_n(a.data(), b.data(), out.data(), n));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_CastScalar(benchmark::State& state) {
+  auto n = static_cast<std::size_t>(state.range(0));
+  auto in = make_amounts<std::int64_t>(n, 3);
+  std::vector<std::int32_t> out(n);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      auto r = checked_cast<std::int32_t>(in[i]);
+      if (r.is_err()) {
+        break;
+      }
+      out[i] = r.unchecked_ok();
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_CastBatch(benchmark::State& state) {
+  auto n = static_cast<std::size_t>(state.range(0));
+  auto in = make_amounts<std::int64_t>(n, 3);
+  std::vector<std::int32_t> out(n);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(checked_cast_n(in.data(), out.data(), n));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_AddScalar<std::int64_t>)->Arg(4096);
+BENCHMARK(BM_AddResult<std::int64_t>)->Arg(4096);
+BENCHMARK(BM_AddBatch<std::int64_t>)->Arg(4096);
+BENCHMARK(BM_AddScalar<std::int32_t>)->Arg(4096);
+BENCHMARK(BM_AddBatch<std::int32_t>)->Arg(4096);
+BENCHMARK(BM_MulScalar<std::int16_t>)->Arg(4096);
+BENCHMARK(BM_MulBatch<std::int16_t>)->Arg(4096);
+BENCHMARK(BM_MulScalar<std::int32_t>)->Arg(4096);
+BENCHMARK(BM_MulBatch<std::int32_t>)->Arg(4096);
+BENCHMARK(BM_MulScalar<std::int64_t>)->Arg(4096);
+BENCHMARK(BM_MulBatch<std::int64_t>)->Arg(4096);
+BENCHMARK(BM_CastScalar)->Arg(4096);
+BENCHMARK(BM_CastBatch)->Arg(4096);
+
+}  // namespace
@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/compare.h>
+#include <t9_result/flat_map.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+enum class ErrorCode : std::uint32_t {
+  NotFound = 1,
+  Timeout,
+  Refused,
+  Internal,
+};
+
+using IntResult = Result<std::uint64_t, ErrorCode>;
+
+constexpr std::size_t kCount = 10000000;
+
+// 重複を含む Result の列（1/16 が失敗）
+const std::vector<IntResult>& results() {
+  static const std::vector<IntResult> values = [] {
+    std::vector<IntResult> v;
+    v.reserve(kCount);
+    std::uint64_t state = 1;
+    for (std::size_t i = 0; i < kCount; ++i) {
+      state = state * 6364136223846793005ull + 1442695040888963407ull;
+      std::uint64_t x = state >> 33;
+      if (x % 16 == 0) {
+        v.push_back(make_err(static_cast<ErrorCode>(1 + (x >> 4) % 4)));
+      } else {
+        // 値の範囲を絞って重複させる
+        v.push_back(make_ok(x % (kCount / 2)));
+      }
+    }
+    return v;
+  }();
+  return values;
+}
+
+// 判別子と値を個別に取り出して比較する従来の書き方
+bool manual_less(const IntResult& a, const IntResult& b) {
+  if (a.is_ok() && b.is_ok()) {
+    return a.ref_ok() < b.ref_ok();
+  }
+  if (a.is_err() && b.is_err()) {
+    return a.ref_err() < b.ref_err();
+  }
+  return a.is_ok();
+}
+
+bool manual_equal(const IntResult& a, const IntResult& b) {
+  if (a.is_ok() && b.is_ok()) {
+    return a.ref_ok() == b.ref_ok();
+  }
+  if (a.is_err() && b.is_err()) {
+    return a.ref_err() == b.ref_err();
+  }
+  return false;
+}
+
+// 手書きの比較関数でソート
+void BM_SortManual(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto values = results();
+    state.ResumeTiming();
+    std::sort(values.begin(), values.end(), manual_less);
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_SortManual)->Unit(benchmark::kMillisecond);
+
+// operator< でソート
+void BM_SortOperator(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto values = results();
+    state.ResumeTiming();
+    std::sort(values.begin(), values.end());
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_SortOperator)->Unit(benchmark::kMillisecond);
+
+// ソート済みの列から手書きの比較関数で重複を除去
+void BM_UniqueManual(benchmark::State& state) {
+  auto sorted = results();
+  std::sort(sorted.begin(), sorted.end());
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto values = sorted;
+    state.ResumeTiming();
+    auto end = std::unique(values.begin(), values.end(), manual_equal);
+    benchmark::DoNotOptimize(end);
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_UniqueManual)->Unit(benchmark::kMillisecond);
+
+// ソート済みの列から operator== で重複を除去
+void BM_UniqueOperator(benchmark::State& state) {
+  auto sorted = results();
+  std::sort(sorted.begin(), sorted.end());
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto values = sorted;
+    state.ResumeTiming();
+    auto end = std::unique(values.begin(), values.end());
+    benchmark::DoNotOptimize(end);
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_UniqueOperator)->Unit(benchmark::kMillisecond);
+
+// std::hash と FlatMap でソートせずに重複を除去
+void BM_DedupHash(benchmark::State& state) {
+  const auto& values = results();
+  for (auto _ : state) {
+    FlatMap<IntResult, char> seen;
+    seen.reserve(kCount / 2).unwrap();
+    for (const auto& r : values) {
+      seen.try_insert(r, 0);
+    }
+    benchmark::DoNotOptimize(seen.size());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_DedupHash)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""ビルドプロファイルごとにベンチマークを実行し、結果を並べて表示する
+
+CMakePresets.json の bench* プリセットを構成・ビルドして t9_result_bench を
+実行します。bench-pgo-use を指定した場合は、先に bench-pgo-generate で
+計装ビルドを作成し、ベンチマークを学習用ワークロードとして実行してから
+プロファイルを用いて再ビルドします。
+"""
+
+import argparse
+import glob
+import json
+import os
+import shutil
+import subprocess
+
+SOURCE_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+PROFILE_DIR = os.path.join(SOURCE_DIR, "build", "pgo-profile")
+TIME_SCALE = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def run(command, **kwargs):
+    print("+", " ".join(command), flush=True)
+    subprocess.run(command, check=True, cwd=SOURCE_DIR, **kwargs)
+
+
+def build(preset, clean_first=False):
+    run(["cmake", "--preset", preset])
+    command = ["cmake", "--build", "--preset", preset]
+    if clean_first:
+        command.append("--clean-first")
+    run(command)
+    return os.path.join(SOURCE_DIR, "build", preset)
+
+
+def compiler_id(build_dir):
+    with open(os.path.join(build_dir, "CMakeCache.txt")) as f:
+        for line in f:
+            if line.startswith("CMAKE_CXX_COMPILER_ID:"):
+                return line.split("=", 1)[1].strip()
+    return ""
+
+
+def bench_executable(build_dir):
+    candidates = glob.glob(os.path.join(build_dir, "**", "t9_result_bench*"),
+                           recursive=True)
+    executables = [c for c in candidates if os.access(c, os.X_OK)
+                   and os.path.isfile(c)]
+    if not executables:
+        raise SystemExit(f"t9_result_bench not found in {build_dir}")
+    return executables[0]
+
+
+def train():
+    """計装ビルドでベンチマークを実行し、プロファイルを収集する"""
+    shutil.rmtree(PROFILE_DIR, ignore_errors=True)
+    build_dir = build("bench-pgo-generate", clean_first=True)
+    run([bench_executable(build_dir), "--benchmark_min_time=0.05"])
+    if "Clang" in compiler_id(build_dir):
+        run(["llvm-profdata", "merge",
+             f"-output={os.path.join(PROFILE_DIR, 'default.profdata')}",
+             *glob.glob(os.path.join(PROFILE_DIR, "*.profraw"))])
+
+
+def measure(preset, args):
+    if preset == "bench-pgo-use":
+        train()
+    build_dir = build(preset, clean_first=preset == "bench-pgo-use")
+    output = os.path.join(build_dir, "bench_results.json")
+    command = [bench_executable(build_dir), f"--benchmark_out={output}",
+               "--benchmark_out_format=json",
+               f"--benchmark_repetitions={args.repetitions}",
+               "--benchmark_report_aggregates_only=true"]
+    if args.filter:
+        command.append(f"--benchmark_filter={args.filter}")
+    run(command, stdout=subprocess.DEVNULL)
+
+    with open(output) as f:
+        data = json.load(f)
+    results = {}
+    for b in data["benchmarks"]:
+        if b.get("aggregate_name", "mean") != "mean":
+            continue
+        name = b.get("run_name", b["name"])
+        results[name] = b["cpu_time"] * TIME_SCALE[b["time_unit"]]
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--presets", nargs="+",
+                        default=["bench", "bench-lto", "bench-native",
+                                 "bench-pgo-use"])
+    parser.add_argument("--filter", help="benchmark filter regex")
+    parser.add_argument("--repetitions", type=int, default=3)
+    args = parser.parse_args()
+
+    table = {preset: measure(preset, args) for preset in args.presets}
+
+    baseline = table[args.presets[0]]
+    width = max(len(name) for name in baseline)
+    header = f"{'benchmark [ns]':<{width}}"
+    for preset in args.presets:
+        header += f" {preset:>20}"
+    print(header)
+    for name, base in baseline.items():
+        row = f"{name:<{width}}"
+        for preset in args.presets:
+            value = table[preset].get(name)
+            if value is None:
+                row += f" {'-':>20}"
+            else:
+                row += f" {value:>12.1f} ({base / value:4.2f}x)"
+        print(row)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""t9_result を使う翻訳単位のコンパイル時間を計測する
+
+各ケースを指定回数コンパイルし、壁時計時間とオブジェクトサイズを報告します。
+--time-trace を指定すると、Clang では -ftime-trace の JSON を、
+GCC では -ftime-report の出力を出力ディレクトリに保存します。
+
+ケースは "<名前>=<ソース>[,<マクロ定義>...]" の形式で指定します。
+--chain-lengths を指定すると、指定した長さのコンビネータチェーン
+（map/map_err/and_then を成功値・失敗値の型を変えながら連ねたもの）を
+生成してケースに加えます。
+"""
+
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+import time
+
+
+def parse_case(text):
+    name, _, rest = text.partition("=")
+    if not name or not rest:
+        raise argparse.ArgumentTypeError(f"invalid case: {text}")
+    source, *defines = rest.split(",")
+    return {"name": name, "source": source, "defines": defines}
+
+
+def compiler_version(cxx):
+    return subprocess.run([cxx, "--version"], capture_output=True,
+                          text=True).stdout.splitlines()[0]
+
+
+def compiler_kind(version):
+    return "clang" if "clang" in version else "gcc"
+
+
+def generate_chain(output_dir, length):
+    """長さ length のコンビネータチェーンを含むソースを生成する"""
+    lines = [
+        "#include <t9_result/prelude.h>",
+        "",
+        "#include <utility>",
+        "",
+        "template <int N>",
+        "struct V {",
+        "  int m_value;",
+        "};",
+        "",
+        "template <int N>",
+        "struct Er {",
+        "  int m_code;",
+        "};",
+        "",
+        "auto chain(t9_result::Result<V<0>, Er<0>> r) {",
+        "  return std::move(r)",
+    ]
+    t, e = 0, 0
+    for i in range(length):
+        if i % 3 == 0:
+            lines.append(f"      .map([](V<{t}> v) {{ return V<{t + 1}>{{v.m_value + 1}}; }})")
+            t += 1
+        elif i % 3 == 1:
+            lines.append(f"      .map_err([](Er<{e}> x) {{ return Er<{e + 1}>{{x.m_code}}; }})")
+            e += 1
+        else:
+            lines.append(f"      .and_then([](V<{t}> v) -> t9_result::Result<V<{t + 1}>, Er<{e}>> {{")
+            lines.append(f"        return t9_result::make_ok(V<{t + 1}>{{v.m_value * 2}});")
+            lines.append("      })")
+            t += 1
+    lines[-1] += ";"
+    lines.append("}")
+    lines.append("")
+    lines.append("int run_chain(int x) {")
+    lines.append("  t9_result::Result<V<0>, Er<0>> r = t9_result::make_ok(V<0>{x});")
+    lines.append("  return chain(std::move(r)).match(")
+    lines.append("      [](auto v) { return v.m_value; }, [](auto e) { return e.m_code; });")
+    lines.append("}")
+
+    path = os.path.join(output_dir, f"chain_{length}.cpp")
+    with open(path, "w") as f:
+        f.write("\n".join(lines) + "\n")
+    return {"name": f"chain_{length}", "source": path, "defines": []}
+
+
+def compile_case(args, kind, case):
+    obj = os.path.join(args.output_dir, case["name"] + ".o")
+    command = [args.cxx, f"-std={args.std}", "-fno-exceptions", "-fno-rtti",
+               f"-I{args.include_dir}", *args.flags, "-c", case["source"],
+               "-o", obj]
+    command += [f"-D{define}" for define in case["defines"]]
+
+    times = []
+    for i in range(args.repeat):
+        trace = args.time_trace and i == args.repeat - 1
+        extra = []
+        if trace:
+            extra = ["-ftime-trace"] if kind == "clang" else ["-ftime-report"]
+        begin = time.perf_counter()
+        completed = subprocess.run(command + extra, capture_output=True,
+                                   text=True)
+        times.append(time.perf_counter() - begin)
+        if completed.returncode != 0:
+            sys.stderr.write(completed.stderr)
+            raise SystemExit(f"failed to compile {case['name']}")
+        if trace and kind == "gcc":
+            report = os.path.join(args.output_dir, case["name"] + ".time-report")
+            with open(report, "w") as f:
+                f.write(completed.stderr)
+
+    return {
+        "name": case["name"],
+        "mean_sec": statistics.mean(times),
+        "min_sec": min(times),
+        "object_bytes": os.path.getsize(obj),
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--cxx", required=True, help="C++ compiler")
+    parser.add_argument("--include-dir", required=True)
+    parser.add_argument("--std", default="c++17")
+    parser.add_argument("--flag", dest="flags", action="append", default=[],
+                        help="additional compiler flag")
+    parser.add_argument("--repeat", type=int, default=5)
+    parser.add_argument("--time-trace", action="store_true")
+    parser.add_argument("--output-dir", default=".")
+    parser.add_argument("--json", help="write results to this file")
+    parser.add_argument("--chain-lengths",
+                        type=lambda text: [int(n) for n in text.split(",")],
+                        default=[], help="comma separated chain lengths")
+    parser.add_argument("cases", nargs="*", type=parse_case)
+    args = parser.parse_args()
+
+    os.makedirs(args.output_dir, exist_ok=True)
+    version = compiler_version(args.cxx)
+    kind = compiler_kind(version)
+    cases = args.cases + [generate_chain(args.output_dir, length)
+                          for length in args.chain_lengths]
+    results = [compile_case(args, kind, case) for case in cases]
+
+    print(f"{'case':<32} {'mean[s]':>10} {'min[s]':>10} {'object[B]':>12}")
+    for r in results:
+        print(f"{r['name']:<32} {r['mean_sec']:>10.3f} {r['min_sec']:>10.3f} "
+              f"{r['object_bytes']:>12}")
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump({"compiler": args.cxx, "version": version,
+                       "flags": args.flags, "results": results}, f, indent=2)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,25 @@
+// テンプレートのインスタンス化コストを計測する
+// T9_RESULT_COMPILE_BENCH_EXTERN を定義すると extern template を使用する
+#include <t9_result/prelude.h>
+
+template <int N>
+struct Value {
+  int m_value;
+};
+
+#define T9_RESULT_COMPILE_BENCH_TYPES(X) \
+  X(0) X(1) X(2) X(3) X(4) X(5) X(6) X(7) X(8) X(9)
+
+#ifdef T9_RESULT_COMPILE_BENCH_EXTERN
+#define T9_RESULT_COMPILE_BENCH_DECLARE(N) \
+  T9_RESULT_EXTERN_TEMPLATE(Value<N>, int);
+T9_RESULT_COMPILE_BENCH_TYPES(T9_RESULT_COMPILE_BENCH_DECLARE)
+#endif
+
+#define T9_RESULT_COMPILE_BENCH_USE(N)                        \
+  int use_##N(t9_result::Result<Value<N>, int> r) {           \
+    int sum = r.is_ok() ? r.ref_ok().m_value : r.ref_err();   \
+    sum += r.is_err() ? r.unchecked_err() : 0;                \
+    return sum + r.unwrap_or(Value<N>{N}).m_value;            \
+  }
+T9_RESULT_COMPILE_BENCH_TYPES(T9_RESULT_COMPILE_BENCH_USE)
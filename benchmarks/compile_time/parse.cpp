@@ -0,0 +1,10 @@
+// ヘッダの解析コストを計測する
+// T9_RESULT_COMPILE_BENCH_FWD を定義すると前方宣言ヘッダのみを使用する
+#ifdef T9_RESULT_COMPILE_BENCH_FWD
+#include <t9_result/result_fwd.h>
+#else
+#include <t9_result/prelude.h>
+#endif
+
+t9_result::Result<int, int> parse_int(const char* text);
+t9_result::Result<void, int> validate(const char* text);
@@ -0,0 +1,142 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/flat_map.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+// 重複しにくい疑似乱数のキー列を生成する
+std::vector<std::uint64_t> make_keys(std::size_t count, std::uint64_t seed) {
+  std::vector<std::uint64_t> keys(count);
+  for (auto& key : keys) {
+    seed += 0x9E3779B97F4A7C15ull;
+    std::uint64_t z = seed;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    key = z ^ (z >> 31);
+  }
+  return keys;
+}
+
+void entry_counts(benchmark::internal::Benchmark* b) {
+  for (std::int64_t count = 1000; count <= 10000000; count *= 10) {
+    b->Arg(count);
+  }
+}
+
+// std::unordered_map の検索（ヒット）
+void BM_UnorderedMapFind(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  auto keys = make_keys(count, 1);
+  std::unordered_map<std::uint64_t, std::uint64_t> map;
+  map.reserve(count);
+  for (auto key : keys) {
+    map.emplace(key, key);
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto it = map.find(keys[i]);
+    benchmark::DoNotOptimize(it != map.end() ? &it->second : nullptr);
+    i = i + 1 == count ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UnorderedMapFind)->Apply(entry_counts);
+
+// FlatMap の検索（ヒット）
+void BM_FlatMapGet(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  auto keys = make_keys(count, 1);
+  FlatMap<std::uint64_t, std::uint64_t> map;
+  map.reserve(count).unwrap();
+  for (auto key : keys) {
+    map.try_insert(key, key);
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto value = map.try_get(keys[i]);
+    benchmark::DoNotOptimize(value.is_ok() ? &value.unwrap() : nullptr);
+    i = i + 1 == count ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FlatMapGet)->Apply(entry_counts);
+
+// std::unordered_map の検索（ミス）
+void BM_UnorderedMapFindMiss(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  auto keys = make_keys(count, 1);
+  auto missing = make_keys(count, 2);
+  std::unordered_map<std::uint64_t, std::uint64_t> map;
+  map.reserve(count);
+  for (auto key : keys) {
+    map.emplace(key, key);
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.find(missing[i]) != map.end());
+    i = i + 1 == count ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UnorderedMapFindMiss)->Apply(entry_counts);
+
+// FlatMap の検索（ミス）
+void BM_FlatMapGetMiss(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  auto keys = make_keys(count, 1);
+  auto missing = make_keys(count, 2);
+  FlatMap<std::uint64_t, std::uint64_t> map;
+  map.reserve(count).unwrap();
+  for (auto key : keys) {
+    map.try_insert(key, key);
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.try_get(missing[i]).is_err());
+    i = i + 1 == count ? 0 : i + 1;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FlatMapGetMiss)->Apply(entry_counts);
+
+// std::unordered_map への挿入（reserve 済み）
+void BM_UnorderedMapInsert(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  auto keys = make_keys(count, 1);
+  for (auto _ : state) {
+    std::unordered_map<std::uint64_t, std::uint64_t> map;
+    map.reserve(count);
+    for (auto key : keys) {
+      map.emplace(key, key);
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_UnorderedMapInsert)
+    ->Apply(entry_counts)
+    ->Unit(benchmark::kMicrosecond);
+
+// FlatMap への挿入（reserve 済み）
+void BM_FlatMapInsert(benchmark::State& state) {
+  auto count = static_cast<std::size_t>(state.range(0));
+  auto keys = make_keys(count, 1);
+  for (auto _ : state) {
+    FlatMap<std::uint64_t, std::uint64_t> map;
+    map.reserve(count).unwrap();
+    for (auto key : keys) {
+      map.try_insert(key, key);
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_FlatMapInsert)->Apply(entry_counts)->Unit(benchmark::kMicrosecond);
+
+}  // namespace
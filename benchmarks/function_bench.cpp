@@ -0,0 +1,131 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/function.h>
+#include <t9_result/result.h>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+constexpr std::size_t kCount = 1024;
+
+// 8件に1件が失敗するResultの列
+std::vector<Result<int, int>> make_results() {
+  std::vector<Result<int, int>> results;
+  results.reserve(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    auto v = static_cast<int>(i);
+    if (i % 8 == 0) {
+      results.push_back(make_err(v));
+    } else {
+      results.push_back(make_ok(v));
+    }
+  }
+  return results;
+}
+
+// 失敗値と成功値をそれぞれハンドラに渡す
+template <typename OnOk, typename OnErr>
+void run(benchmark::State& state, OnOk& on_ok, OnErr& on_err) {
+  auto results = make_results();
+  for (auto _ : state) {
+    // ハンドラの中身を既知として最適化されないようにする
+    benchmark::DoNotOptimize(on_ok);
+    benchmark::DoNotOptimize(on_err);
+    for (auto& r : results) {
+      r.inspect_ok(on_ok).inspect_err(on_err);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+
+// テンプレート引数としてラムダを渡す（インライン化される）
+void BM_HandlerTemplate(benchmark::State& state) {
+  long sum = 0;
+  long errors = 0;
+  auto on_ok = [&sum](const int& v) { sum += v; };
+  auto on_err = [&errors](const int& e) { errors += e; };
+  run(state, on_ok, on_err);
+  benchmark::DoNotOptimize(sum + errors);
+}
+BENCHMARK(BM_HandlerTemplate);
+
+// FunctionRef 経由で呼び出す
+void BM_HandlerFunctionRef(benchmark::State& state) {
+  long sum = 0;
+  long errors = 0;
+  auto ok_lambda = [&sum](const int& v) { sum += v; };
+  auto err_lambda = [&errors](const int& e) { errors += e; };
+  FunctionRef<void(const int&)> on_ok = ok_lambda;
+  FunctionRef<void(const int&)> on_err = err_lambda;
+  run(state, on_ok, on_err);
+  benchmark::DoNotOptimize(sum + errors);
+}
+BENCHMARK(BM_HandlerFunctionRef);
+
+// UniqueFunction 経由で呼び出す
+void BM_HandlerUniqueFunction(benchmark::State& state) {
+  long sum = 0;
+  long errors = 0;
+  UniqueFunction<void(const int&)> on_ok = [&sum](const int& v) {
+    sum += v;
+  };
+  UniqueFunction<void(const int&)> on_err = [&errors](const int& e) {
+    errors += e;
+  };
+  run(state, on_ok, on_err);
+  benchmark::DoNotOptimize(sum + errors);
+}
+BENCHMARK(BM_HandlerUniqueFunction);
+
+// std::function 経由で呼び出す
+void BM_HandlerStdFunction(benchmark::State& state) {
+  long sum = 0;
+  long errors = 0;
+  std::function<void(const int&)> on_ok = [&sum](const int& v) { sum += v; };
+  std::function<void(const int&)> on_err = [&errors](const int& e) {
+    errors += e;
+  };
+  run(state, on_ok, on_err);
+  benchmark::DoNotOptimize(sum + errors);
+}
+BENCHMARK(BM_HandlerStdFunction);
+
+// ハンドラの生成と破棄を含むコスト（大きなキャプチャ）
+struct Capture {
+  long* m_target;
+  long m_padding[2];
+};
+
+void BM_ConstructUniqueFunction(benchmark::State& state) {
+  long total = 0;
+  Capture capture{&total, {1, 2}};
+  for (auto _ : state) {
+    UniqueFunction<void(int)> f = [capture](int v) {
+      *capture.m_target += v + capture.m_padding[0];
+    };
+    benchmark::DoNotOptimize(f);
+    f(1);
+  }
+  benchmark::DoNotOptimize(total);
+}
+BENCHMARK(BM_ConstructUniqueFunction);
+
+void BM_ConstructStdFunction(benchmark::State& state) {
+  long total = 0;
+  Capture capture{&total, {1, 2}};
+  for (auto _ : state) {
+    std::function<void(int)> f = [capture](int v) {
+      *capture.m_target += v + capture.m_padding[0];
+    };
+    benchmark::DoNotOptimize(f);
+    f(1);
+  }
+  benchmark::DoNotOptimize(total);
+}
+BENCHMARK(BM_ConstructStdFunction);
+
+}  // namespace
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/latency.h>
+
+#include <cstdint>
+
+namespace {
+
+using namespace t9_result;
+
+Result<std::uint64_t, int> work(std::uint64_t x) {
+  if (x % 64 == 0) {
+    return make_err(static_cast<int>(x));
+  }
+  return make_ok(x * 3);
+}
+
+// 計測なしの呼び出し
+void BM_CallPlain(benchmark::State& state) {
+  std::uint64_t x = 0;
+  for (auto _ : state) {
+    auto r = work(++x);
+    benchmark::DoNotOptimize(r);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CallPlain);
+
+// timed() で計測した呼び出し
+void BM_CallTimed(benchmark::State& state) {
+  static LatencySite site("bench.timed");
+  std::uint64_t x = 0;
+  for (auto _ : state) {
+    auto r = timed(site, [&x] { return work(++x); });
+    benchmark::DoNotOptimize(r);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CallTimed)->Threads(1)->Threads(4);
+
+// 時計の読み出しのみ
+void BM_ClockRead(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(detail::latency_now());
+  }
+}
+BENCHMARK(BM_ClockRead);
+
+// 記録のみ（バケット計算とシャードへの加算）
+void BM_Record(benchmark::State& state) {
+  static LatencySite site("bench.record");
+  std::uint64_t x = 0;
+  for (auto _ : state) {
+    site.record(x % 64 != 0, (x * 37) & 0xFFFFF);
+    ++x;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Record);
+
+// 4スレッド分のシャードの合算
+void BM_Snapshot(benchmark::State& state) {
+  static LatencySite site("bench.snapshot");
+  if (state.thread_index() == 0) {
+    for (std::uint64_t i = 0; i < 100000; ++i) {
+      site.record(i % 64 != 0, i);
+    }
+  }
+  for (auto _ : state) {
+    auto snapshot = site.snapshot();
+    benchmark::DoNotOptimize(snapshot.m_ok.percentile(0.99));
+  }
+}
+BENCHMARK(BM_Snapshot);
+
+}  // namespace
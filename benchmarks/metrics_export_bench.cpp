@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/metrics_export.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+// 1万箇所の呼び出し箇所を持つプロセスを模擬する
+class ManySites {
+ private:
+  std::vector<std::string> m_names;
+  std::vector<std::unique_ptr<LatencySite>> m_sites;
+
+ public:
+  explicit ManySites(std::size_t count) : m_names(count) {
+    m_sites.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+      m_names[i] = "bench.site." + std::to_string(i);
+      m_sites.push_back(std::make_unique<LatencySite>(m_names[i].c_str()));
+      for (std::uint64_t j = 0; j < 8; ++j) {
+        m_sites[i]->record(j != 0, (i + 1) * (j + 1) * 100);
+      }
+      m_sites[i]->record_error_code(static_cast<std::int64_t>(i % 8));
+    }
+  }
+
+  LatencySite& operator[](std::size_t i) {
+    return *m_sites[i];
+  }
+};
+
+ManySites& sites() {
+  static ManySites instance(10000);
+  return instance;
+}
+
+// 全呼び出し箇所のシャードの合算のみ
+void BM_SnapshotAllSites(benchmark::State& state) {
+  sites();
+  for (auto _ : state) {
+    std::uint64_t total = 0;
+    LatencyRegistry::instance().for_each([&total](LatencySite& site) {
+      total += site.snapshot().m_err.count();
+    });
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * 10000);
+}
+BENCHMARK(BM_SnapshotAllSites)->Unit(benchmark::kMillisecond);
+
+void BM_FormatPrometheus(benchmark::State& state) {
+  sites();
+  std::string text;
+  for (auto _ : state) {
+    text.clear();
+    format_metrics(MetricsFormat::Prometheus, text);
+    benchmark::DoNotOptimize(text.data());
+  }
+  state.SetItemsProcessed(state.iterations() * 10000);
+  state.counters["bytes"] = static_cast<double>(text.size());
+}
+BENCHMARK(BM_FormatPrometheus)->Unit(benchmark::kMillisecond);
+
+void BM_FormatJson(benchmark::State& state) {
+  sites();
+  std::string text;
+  for (auto _ : state) {
+    text.clear();
+    format_metrics(MetricsFormat::Json, text);
+    benchmark::DoNotOptimize(text.data());
+  }
+  state.SetItemsProcessed(state.iterations() * 10000);
+  state.counters["bytes"] = static_cast<double>(text.size());
+}
+BENCHMARK(BM_FormatJson)->Unit(benchmark::kMillisecond);
+
+// 変換中の別スレッドの記録コスト（変換なしの場合と比較する）
+void BM_RecordDuringExport(benchmark::State& state) {
+  ManySites& all = sites();
+  std::atomic<bool> running{state.range(0) != 0};
+  std::thread exporter([&running] {
+    std::string text;
+    while (running.load(std::memory_order_relaxed)) {
+      text.clear();
+      format_metrics(MetricsFormat::Prometheus, text);
+    }
+  });
+  std::uint64_t i = 0;
+  for (auto _ : state) {
+    all[i % 10000].record(true, i & 0xFFFF);
+    ++i;
+  }
+  running.store(false, std::memory_order_relaxed);
+  exporter.join();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RecordDuringExport)->Arg(0)->Arg(1);
+
+}  // namespace
@@ -0,0 +1,47 @@
+#!/usr/bin/env python3
+"""#include と import のビルド時間を比較する
+
+構成済みのビルドディレクトリを受け取り、モジュール本体を構築した後、
+bench_include と bench_import をそれぞれクリーンな状態からビルドして
+壁時計時間を報告します。
+"""
+
+import argparse
+import statistics
+import subprocess
+import time
+
+
+def build(build_dir, target, jobs):
+    command = ["cmake", "--build", build_dir, "--target", target]
+    if jobs:
+        command += ["-j", str(jobs)]
+    begin = time.perf_counter()
+    subprocess.run(command, check=True, stdout=subprocess.DEVNULL)
+    return time.perf_counter() - begin
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("build_dir")
+    parser.add_argument("--repeat", type=int, default=3)
+    parser.add_argument("--jobs", type=int)
+    args = parser.parse_args()
+
+    results = {"bench_include": [], "bench_import": []}
+    for _ in range(args.repeat):
+        for target in results:
+            subprocess.run(["cmake", "--build", args.build_dir, "--target",
+                            "clean"], check=True, stdout=subprocess.DEVNULL)
+            # モジュールのBMI生成は一度きりのコストなので計測から除く
+            build(args.build_dir, "t9_result_module", args.jobs)
+            results[target].append(build(args.build_dir, target, args.jobs))
+
+    print(f"{'target':<16} {'mean[s]':>10} {'min[s]':>10}")
+    for target, times in results.items():
+        print(f"{target:<16} {statistics.mean(times):>10.3f} "
+              f"{min(times):>10.3f}")
+
+
+if __name__ == "__main__":
+    main()
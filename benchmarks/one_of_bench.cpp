@@ -0,0 +1,182 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/one_of.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+
+#if defined(_MSC_VER)
+#define T9_BENCH_NOINLINE __declspec(noinline)
+#else
+#define T9_BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+namespace {
+
+using namespace t9_result;
+
+// 各層が追加する失敗値
+struct E1 {
+  std::int32_t m_line;
+  std::int32_t m_column;
+};
+enum class E2 : std::uint8_t { Timeout = 1 };
+struct E3 {
+  std::int32_t m_errno;
+};
+struct E4 {
+  std::uint64_t m_id;
+};
+enum class E5 : std::uint8_t { Conflict = 1 };
+
+constexpr std::size_t kInputs = 1024;
+
+// 入力の 1/32 ずつが各層で失敗する
+bool fails(std::uint64_t x, std::uint64_t layer) {
+  return x % 32 == layer;
+}
+
+Result<std::uint64_t, E1> layer1(std::uint64_t x) {
+  if (fails(x, 1)) {
+    return make_err(E1{static_cast<std::int32_t>(x), 1});
+  }
+  return make_ok(x);
+}
+
+// OneOf で失敗値の型を広げながら伝搬する
+namespace one_of {
+
+using R2 = Result<std::uint64_t, OneOf<E1, E2>>;
+using R3 = Result<std::uint64_t, OneOf<E1, E2, E3>>;
+using R4 = Result<std::uint64_t, OneOf<E1, E2, E3, E4>>;
+using R5 = Result<std::uint64_t, OneOf<E1, E2, E3, E4, E5>>;
+
+T9_BENCH_NOINLINE R2 layer2(std::uint64_t x) {
+  return layer1(x).and_then([](std::uint64_t v) -> R2 {
+    if (fails(v, 2)) {
+      return make_err(E2::Timeout);
+    }
+    return make_ok(v + 1);
+  });
+}
+
+T9_BENCH_NOINLINE R3 layer3(std::uint64_t x) {
+  return layer2(x).and_then([x](std::uint64_t v) -> R3 {
+    if (fails(x, 3)) {
+      return make_err(E3{5});
+    }
+    return make_ok(v + 1);
+  });
+}
+
+T9_BENCH_NOINLINE R4 layer4(std::uint64_t x) {
+  return layer3(x).and_then([x](std::uint64_t v) -> R4 {
+    if (fails(x, 4)) {
+      return make_err(E4{v});
+    }
+    return make_ok(v + 1);
+  });
+}
+
+T9_BENCH_NOINLINE R5 layer5(std::uint64_t x) {
+  return layer4(x).and_then([x](std::uint64_t v) -> R5 {
+    if (fails(x, 5)) {
+      return make_err(E5::Conflict);
+    }
+    return make_ok(v + 1);
+  });
+}
+
+}  // namespace one_of
+
+// std::variant の失敗値を各層で map_err して広げながら伝搬する
+namespace variant {
+
+using V2 = std::variant<E1, E2>;
+using V3 = std::variant<E1, E2, E3>;
+using V4 = std::variant<E1, E2, E3, E4>;
+using V5 = std::variant<E1, E2, E3, E4, E5>;
+
+template <typename To>
+struct Widen {
+  template <typename From>
+  To operator()(From&& from) const {
+    return std::visit([](auto&& e) -> To { return e; }, from);
+  }
+};
+
+T9_BENCH_NOINLINE Result<std::uint64_t, V2> layer2(std::uint64_t x) {
+  return layer1(x).map_err([](E1 e) { return V2(e); })
+      .and_then([](std::uint64_t v) -> Result<std::uint64_t, V2> {
+        if (fails(v, 2)) {
+          return make_err(V2(E2::Timeout));
+        }
+        return make_ok(v + 1);
+      });
+}
+
+T9_BENCH_NOINLINE Result<std::uint64_t, V3> layer3(std::uint64_t x) {
+  return layer2(x).map_err(Widen<V3>{}).and_then(
+      [x](std::uint64_t v) -> Result<std::uint64_t, V3> {
+        if (fails(x, 3)) {
+          return make_err(V3(E3{5}));
+        }
+        return make_ok(v + 1);
+      });
+}
+
+T9_BENCH_NOINLINE Result<std::uint64_t, V4> layer4(std::uint64_t x) {
+  return layer3(x).map_err(Widen<V4>{}).and_then(
+      [x](std::uint64_t v) -> Result<std::uint64_t, V4> {
+        if (fails(x, 4)) {
+          return make_err(V4(E4{v}));
+        }
+        return make_ok(v + 1);
+      });
+}
+
+T9_BENCH_NOINLINE Result<std::uint64_t, V5> layer5(std::uint64_t x) {
+  return layer4(x).map_err(Widen<V5>{}).and_then(
+      [x](std::uint64_t v) -> Result<std::uint64_t, V5> {
+        if (fails(x, 5)) {
+          return make_err(V5(E5::Conflict));
+        }
+        return make_ok(v + 1);
+      });
+}
+
+}  // namespace variant
+
+// OneOf による5層の伝搬
+void BM_PropagateOneOf(benchmark::State& state) {
+  for (auto _ : state) {
+    std::size_t errors[5] = {};
+    for (std::uint64_t x = 0; x < kInputs; ++x) {
+      auto r = one_of::layer5(x);
+      if (r.is_err()) {
+        ++errors[r.ref_err().index()];
+      }
+    }
+    benchmark::DoNotOptimize(errors);
+  }
+  state.SetItemsProcessed(state.iterations() * kInputs);
+}
+BENCHMARK(BM_PropagateOneOf);
+
+// std::variant による5層の伝搬
+void BM_PropagateVariant(benchmark::State& state) {
+  for (auto _ : state) {
+    std::size_t errors[5] = {};
+    for (std::uint64_t x = 0; x < kInputs; ++x) {
+      auto r = variant::layer5(x);
+      if (r.is_err()) {
+        ++errors[r.ref_err().index()];
+      }
+    }
+    benchmark::DoNotOptimize(errors);
+  }
+  state.SetItemsProcessed(state.iterations() * kInputs);
+}
+BENCHMARK(BM_PropagateVariant);
+
+}  // namespace
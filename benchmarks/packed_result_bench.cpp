@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/packed_result.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+enum class Reason : std::uint8_t {
+  TooShort,
+  TooLong,
+  BadChar,
+  Reserved,
+};
+
+}  // namespace
+
+template <>
+struct t9_result::BitWidth<Reason> {
+  static constexpr unsigned value = 7;
+};
+
+namespace {
+
+// 検査対象の値から検査結果を作る（約1/8が失敗）
+template <typename R>
+R validate(std::uint32_t value) {
+  std::uint32_t h = value * 0x9E3779B9u;
+  if ((h >> 29) == 0) {
+    return make_err(static_cast<Reason>((h >> 8) & 3));
+  }
+  return make_ok(((h >> 8) & 1) != 0);
+}
+
+// 配列に検査結果を書き込む
+template <typename R>
+void BM_Fill(benchmark::State& state) {
+  std::vector<R> results(static_cast<std::size_t>(state.range(0)),
+                         R(make_ok(false)));
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      results[i] = validate<R>(static_cast<std::uint32_t>(i));
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(R));
+}
+
+// 配列を走査して失敗の理由ごとに数える
+template <typename R>
+void BM_Scan(benchmark::State& state) {
+  std::vector<R> results;
+  results.reserve(static_cast<std::size_t>(state.range(0)));
+  for (std::int64_t i = 0; i < state.range(0); ++i) {
+    results.push_back(validate<R>(static_cast<std::uint32_t>(i)));
+  }
+  for (auto _ : state) {
+    std::size_t counts[4] = {};
+    std::size_t passed = 0;
+    for (R& r : results) {
+      if (r.is_err()) {
+        ++counts[static_cast<std::size_t>(r.unwrap_err()) & 3];
+      } else {
+        passed += r.unwrap() ? 1 : 0;
+      }
+    }
+    benchmark::DoNotOptimize(counts);
+    benchmark::DoNotOptimize(passed);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(R));
+}
+
+using Plain = Result<bool, Reason>;
+using Packed = PackedResult<bool, Reason>;
+
+BENCHMARK(BM_Fill<Plain>)->Arg(1 << 20)->Arg(100000000);
+BENCHMARK(BM_Fill<Packed>)->Arg(1 << 20)->Arg(100000000);
+BENCHMARK(BM_Scan<Plain>)->Arg(1 << 20)->Arg(100000000);
+BENCHMARK(BM_Scan<Packed>)->Arg(1 << 20)->Arg(100000000);
+
+}  // namespace
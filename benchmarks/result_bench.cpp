@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/prelude.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+constexpr std::size_t kElementCount = 10'000'000;
+
+// 9割が成功値となる Result の配列を生成する
+const std::vector<Result<int, int>>& results() {
+  static const std::vector<Result<int, int>> s_results = [] {
+    std::vector<Result<int, int>> results;
+    results.reserve(kElementCount);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 9);
+    for (std::size_t i = 0; i < kElementCount; ++i) {
+      int value = static_cast<int>(i & 0xff);
+      if (dist(rng) != 0) {
+        results.push_back(make_ok(value));
+      } else {
+        results.push_back(make_err(value));
+      }
+    }
+    return results;
+  }();
+  return s_results;
+}
+
+// is_ok() で検査してから ref_ok() で取得する
+void BM_RefOk(benchmark::State& state) {
+  const auto& rs = results();
+  for (auto _ : state) {
+    std::int64_t sum = 0;
+    for (const auto& r : rs) {
+      if (r.is_ok()) {
+        sum += r.ref_ok();
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * rs.size());
+}
+BENCHMARK(BM_RefOk)->Unit(benchmark::kMillisecond);
+
+// is_ok() で検査してから unchecked_ok() で取得する
+void BM_UncheckedOk(benchmark::State& state) {
+  const auto& rs = results();
+  for (auto _ : state) {
+    std::int64_t sum = 0;
+    for (const auto& r : rs) {
+      if (r.is_ok()) {
+        sum += r.unchecked_ok();
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * rs.size());
+}
+BENCHMARK(BM_UncheckedOk)->Unit(benchmark::kMillisecond);
+
+// match() で分岐する
+void BM_Match(benchmark::State& state) {
+  const auto& rs = results();
+  for (auto _ : state) {
+    std::int64_t sum = 0;
+    for (const auto& r : rs) {
+      sum += r.match([](int x) { return x; }, [](int) { return 0; });
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * rs.size());
+}
+BENCHMARK(BM_Match)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/serialize.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+using WireResult = Result<std::uint64_t, std::uint32_t>;
+
+constexpr std::size_t kCount = 4096;
+constexpr std::size_t kSlotSize =
+    max_encoded_size<std::uint64_t, std::uint32_t>();
+
+std::vector<WireResult> make_results() {
+  std::vector<WireResult> results;
+  results.reserve(kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    if (i % 8 == 0) {
+      results.push_back(make_err(static_cast<std::uint32_t>(i)));
+    } else {
+      results.push_back(make_ok(static_cast<std::uint64_t>(i)));
+    }
+  }
+  return results;
+}
+
+std::vector<std::byte> make_buffer(const std::vector<WireResult>& results) {
+  std::vector<std::byte> buffer(kCount * kSlotSize);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    encode(results[i], &buffer[i * kSlotSize], kSlotSize);
+  }
+  return buffer;
+}
+
+// 固定長スロットへのエンコード
+void BM_Encode(benchmark::State& state) {
+  auto results = make_results();
+  std::vector<std::byte> buffer(kCount * kSlotSize);
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < kCount; ++i) {
+      auto written = encode(results[i], &buffer[i * kSlotSize], kSlotSize);
+      benchmark::DoNotOptimize(written);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_Encode);
+
+// Resultへのデコード
+void BM_Decode(benchmark::State& state) {
+  auto buffer = make_buffer(make_results());
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < kCount; ++i) {
+      auto decoded = decode<std::uint64_t, std::uint32_t>(
+          &buffer[i * kSlotSize], kSlotSize);
+      auto& r = decoded.ref_ok();
+      sum += r.is_ok() ? r.unchecked_ok() : r.unchecked_err();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_Decode);
+
+// ビューでタグのみを読み出す
+void BM_ViewTag(benchmark::State& state) {
+  auto buffer = make_buffer(make_results());
+  for (auto _ : state) {
+    std::size_t ok_count = 0;
+    for (std::size_t i = 0; i < kCount; ++i) {
+      auto view = ResultView<std::uint64_t, std::uint32_t>::from_bytes(
+          &buffer[i * kSlotSize], kSlotSize);
+      ok_count += view.ref_ok().is_ok();
+    }
+    benchmark::DoNotOptimize(ok_count);
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_ViewTag);
+
+}  // namespace
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/shared_error.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+// 文字列と文脈を値で保持する従来の失敗値
+struct RichError {
+  int m_code;
+  std::string m_message;
+  std::vector<std::string> m_context;
+};
+
+RichError make_rich() {
+  return RichError{503,
+                   "upstream connection refused by 10.0.0.1:8080",
+                   {"fetching user profile", "handling GET /api/v1/users"}};
+}
+
+template <typename E>
+E make_shared() {
+  return E::make(503, "upstream connection refused by 10.0.0.1:8080")
+      .context("fetching user profile")
+      .context("handling GET /api/v1/users");
+}
+
+// 1つの失敗を range(0) 個の待機中のリクエストへ配る
+template <typename E, E (*Make)()>
+void BM_FanOut(benchmark::State& state) {
+  const Result<int, E> failure = make_err(Make());
+  std::vector<Result<int, E>> waiters;
+  waiters.reserve(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+      waiters.push_back(failure);
+    }
+    benchmark::DoNotOptimize(waiters.data());
+    waiters.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FanOut<RichError, make_rich>)->Arg(16)->Arg(256);
+BENCHMARK(BM_FanOut<SharedError, make_shared<SharedError>>)
+    ->Arg(16)
+    ->Arg(256);
+BENCHMARK(BM_FanOut<LocalSharedError, make_shared<LocalSharedError>>)
+    ->Arg(16)
+    ->Arg(256);
+
+// 失敗値の生成と文脈の追加
+void BM_ContextRich(benchmark::State& state) {
+  for (auto _ : state) {
+    RichError error = make_rich();
+    error.m_context.emplace_back("dispatching request");
+    benchmark::DoNotOptimize(error);
+  }
+}
+BENCHMARK(BM_ContextRich);
+
+void BM_ContextShared(benchmark::State& state) {
+  for (auto _ : state) {
+    SharedError error =
+        make_shared<SharedError>().context("dispatching request");
+    benchmark::DoNotOptimize(error);
+  }
+}
+BENCHMARK(BM_ContextShared);
+
+}  // namespace
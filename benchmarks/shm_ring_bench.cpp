@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <t9_result/shm_ring.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using namespace t9_result;
+
+using WireResult = Result<std::uint64_t, std::int32_t>;
+using Ring = ShmResultRing<std::uint64_t, std::int32_t, 1024>;
+
+constexpr std::uint64_t kCount = 100000;
+constexpr std::size_t kSlotSize = Ring::kSlotSize;
+
+WireResult make_result(std::uint64_t i) {
+  if (i % 16 == 0) {
+    return make_err(static_cast<std::int32_t>(i));
+  }
+  return make_ok(i);
+}
+
+std::uint64_t sum_of(const WireResult& result) {
+  return result.match([](std::uint64_t x) { return x; },
+                      [](std::int32_t x) { return std::uint64_t(x); });
+}
+
+void wait_child(pid_t pid) {
+  int status = 0;
+  ::waitpid(pid, &status, 0);
+}
+
+// 共有メモリのリングバッファ
+void BM_ShmRing(benchmark::State& state) {
+  auto ring = Ring::create().unwrap();
+  for (auto _ : state) {
+    pid_t pid = ::fork();
+    if (pid == 0) {
+      for (std::uint64_t i = 0; i < kCount; ++i) {
+        ring.push(make_result(i));
+      }
+      ::_exit(0);
+    }
+    std::uint64_t sum = 0;
+    for (std::uint64_t i = 0; i < kCount; ++i) {
+      sum += sum_of(ring.pop());
+    }
+    benchmark::DoNotOptimize(sum);
+    wait_child(pid);
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_ShmRing)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// ファイルディスクリプタ経由でエンコード済みのスロットを送る
+void transfer_over_fds(benchmark::State& state, int read_fd, int write_fd) {
+  for (auto _ : state) {
+    pid_t pid = ::fork();
+    if (pid == 0) {
+      std::byte slot[kSlotSize];
+      for (std::uint64_t i = 0; i < kCount; ++i) {
+        encode(make_result(i), slot, kSlotSize);
+        std::size_t written = 0;
+        while (written < kSlotSize) {
+          ssize_t n = ::write(write_fd, slot + written, kSlotSize - written);
+          if (n <= 0) {
+            ::_exit(1);
+          }
+          written += static_cast<std::size_t>(n);
+        }
+      }
+      ::_exit(0);
+    }
+    std::uint64_t sum = 0;
+    std::byte slot[kSlotSize];
+    for (std::uint64_t i = 0; i < kCount; ++i) {
+      std::size_t received = 0;
+      while (received < kSlotSize) {
+        ssize_t n = ::read(read_fd, slot + received, kSlotSize - received);
+        if (n <= 0) {
+          state.SkipWithError("read failed");
+          break;
+        }
+        received += static_cast<std::size_t>(n);
+      }
+      sum += sum_of(decode<std::uint64_t, std::int32_t>(slot, kSlotSize)
+                        .unwrap());
+    }
+    benchmark::DoNotOptimize(sum);
+    wait_child(pid);
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+
+// パイプ
+void BM_Pipe(benchmark::State& state) {
+  int fds[2];
+  if (::pipe(fds) != 0) {
+    state.SkipWithError("pipe failed");
+    return;
+  }
+  transfer_over_fds(state, fds[0], fds[1]);
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+BENCHMARK(BM_Pipe)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Unixドメインソケット
+void BM_UnixSocket(benchmark::State& state) {
+  int fds[2];
+  if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+    state.SkipWithError("socketpair failed");
+    return;
+  }
+  transfer_over_fds(state, fds[0], fds[1]);
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+BENCHMARK(BM_UnixSocket)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+}  // namespace
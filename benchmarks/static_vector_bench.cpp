@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/static_string.h>
+#include <t9_result/static_vector.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+constexpr std::size_t kCount = 256;
+
+struct Entry {
+  std::uint64_t m_key;
+  std::uint32_t m_value;
+};
+
+// reserve 済みの std::vector への追加
+void BM_VectorPushBack(benchmark::State& state) {
+  for (auto _ : state) {
+    std::vector<Entry> v;
+    v.reserve(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) {
+      v.push_back(Entry{i, static_cast<std::uint32_t>(i)});
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_VectorPushBack);
+
+// StaticVector への追加
+void BM_StaticVectorPushBack(benchmark::State& state) {
+  for (auto _ : state) {
+    StaticVector<Entry, kCount> v;
+    for (std::size_t i = 0; i < kCount; ++i) {
+      v.try_push_back(Entry{i, static_cast<std::uint32_t>(i)});
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_StaticVectorPushBack);
+
+// reserve 済みの std::string への追加
+void BM_StringAppend(benchmark::State& state) {
+  for (auto _ : state) {
+    std::string s;
+    s.reserve(kCount);
+    for (std::size_t i = 0; i < kCount / 8; ++i) {
+      s.append("abcdefgh");
+    }
+    benchmark::DoNotOptimize(s.data());
+  }
+  state.SetBytesProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_StringAppend);
+
+// StaticString への追加
+void BM_StaticStringAppend(benchmark::State& state) {
+  for (auto _ : state) {
+    StaticString<kCount> s;
+    for (std::size_t i = 0; i < kCount / 8; ++i) {
+      s.try_append("abcdefgh");
+    }
+    benchmark::DoNotOptimize(s.c_str());
+  }
+  state.SetBytesProcessed(state.iterations() * kCount);
+}
+BENCHMARK(BM_StaticStringAppend);
+
+}  // namespace
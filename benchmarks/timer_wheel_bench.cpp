@@ -0,0 +1,164 @@
+#include <benchmark/benchmark.h>
+#include <t9_result/timer_wheel.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+// 1ms 単位で最大約17分先までの期限（接続のアイドルタイムアウトを模擬）
+std::vector<std::uint64_t> make_ticks(std::size_t n) {
+  std::vector<std::uint64_t> ticks(n);
+  std::uint32_t x = 1;
+  for (auto& tick : ticks) {
+    x = x * 1664525u + 1013904223u;
+    tick = 1 + (x >> 12);
+  }
+  return ticks;
+}
+
+std::unique_ptr<TimerWheel> make_filled(const std::vector<std::uint64_t>& ticks,
+                                        std::vector<TimerId>* ids,
+                                        std::size_t* fired) {
+  auto wheel = std::make_unique<TimerWheel>();
+  wheel->reserve(ticks.size());
+  for (auto tick : ticks) {
+    ids->push_back(wheel->schedule_at(tick, [fired] { ++*fired; }));
+  }
+  return wheel;
+}
+
+// range(0) 個のタイマーを登録する
+void BM_TimerWheelSchedule(benchmark::State& state) {
+  auto ticks = make_ticks(static_cast<std::size_t>(state.range(0)));
+  std::size_t fired = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto wheel = std::make_unique<TimerWheel>();
+    wheel->reserve(ticks.size());
+    state.ResumeTiming();
+    for (auto tick : ticks) {
+      benchmark::DoNotOptimize(
+          wheel->schedule_at(tick, [&fired] { ++fired; }));
+    }
+    state.PauseTiming();
+    wheel.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 登録済みの range(0) 個のタイマーを取り消す
+void BM_TimerWheelCancel(benchmark::State& state) {
+  auto ticks = make_ticks(static_cast<std::size_t>(state.range(0)));
+  std::size_t fired = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<TimerId> ids;
+    ids.reserve(ticks.size());
+    auto wheel = make_filled(ticks, &ids, &fired);
+    state.ResumeTiming();
+    for (auto id : ids) {
+      benchmark::DoNotOptimize(wheel->cancel(id));
+    }
+    state.PauseTiming();
+    wheel.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 登録済みの range(0) 個のタイマーを最後の期限まで進めてすべて発火させる
+void BM_TimerWheelExpire(benchmark::State& state) {
+  auto ticks = make_ticks(static_cast<std::size_t>(state.range(0)));
+  std::uint64_t last = 0;
+  for (auto tick : ticks) {
+    last = tick > last ? tick : last;
+  }
+  std::size_t fired = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<TimerId> ids;
+    auto wheel = make_filled(ticks, &ids, &fired);
+    state.ResumeTiming();
+    wheel->advance_to(last);
+    state.PauseTiming();
+    wheel.reset();
+    state.ResumeTiming();
+  }
+  benchmark::DoNotOptimize(fired);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 期限順の std::multimap で管理する従来の方法
+using TimerMap = std::multimap<std::uint64_t, std::function<void()>>;
+
+void BM_MultimapSchedule(benchmark::State& state) {
+  auto ticks = make_ticks(static_cast<std::size_t>(state.range(0)));
+  std::size_t fired = 0;
+  for (auto _ : state) {
+    auto timers = std::make_unique<TimerMap>();
+    for (auto tick : ticks) {
+      benchmark::DoNotOptimize(
+          timers->emplace(tick, [&fired] { ++fired; }));
+    }
+    state.PauseTiming();
+    timers.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_MultimapCancel(benchmark::State& state) {
+  auto ticks = make_ticks(static_cast<std::size_t>(state.range(0)));
+  std::size_t fired = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto timers = std::make_unique<TimerMap>();
+    std::vector<TimerMap::iterator> ids;
+    ids.reserve(ticks.size());
+    for (auto tick : ticks) {
+      ids.push_back(timers->emplace(tick, [&fired] { ++fired; }));
+    }
+    state.ResumeTiming();
+    for (auto id : ids) {
+      timers->erase(id);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_MultimapExpire(benchmark::State& state) {
+  auto ticks = make_ticks(static_cast<std::size_t>(state.range(0)));
+  std::size_t fired = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto timers = std::make_unique<TimerMap>();
+    for (auto tick : ticks) {
+      timers->emplace(tick, [&fired] { ++fired; });
+    }
+    state.ResumeTiming();
+    while (!timers->empty()) {
+      auto first = timers->begin();
+      first->second();
+      timers->erase(first);
+    }
+  }
+  benchmark::DoNotOptimize(fired);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_TimerWheelSchedule)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TimerWheelCancel)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TimerWheelExpire)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MultimapSchedule)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MultimapCancel)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MultimapExpire)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "result.h"
+
+namespace t9_result {
+
+/**
+ * @brief メモリ確保のエラー
+ */
+enum class AllocError {
+  OutOfMemory,   ///< メモリが不足している
+  SizeOverflow,  ///< 要求サイズが表現可能な範囲を超えている
+};
+
+/**
+ * @brief 確保したメモリ領域
+ */
+struct MemoryBlock {
+  std::byte* m_data = nullptr;
+  std::size_t m_size = 0;
+
+  std::byte* data() const {
+    return m_data;
+  }
+
+  std::size_t size() const {
+    return m_size;
+  }
+};
+
+/**
+ * @brief オブジェクトを生成し、失敗時はエラーを返す
+ * @tparam T 生成する型
+ * @tparam Args コンストラクタ引数の型
+ * @param args コンストラクタに渡す引数
+ * @return Result<T*, AllocError> 生成したオブジェクトへのポインタ
+ *
+ * 例外を使わずに new(std::nothrow) で確保します。
+ * 解放には delete を使用してください。
+ */
+template <typename T, typename... Args>
+Result<T*, AllocError> try_new(Args&&... args) {
+  T* p = new (std::nothrow) T(std::forward<Args>(args)...);
+  if (!p) {
+    return make_err(AllocError::OutOfMemory);
+  }
+  return make_ok(p);
+}
+
+/**
+ * @brief オブジェクトを生成して unique_ptr で返し、失敗時はエラーを返す
+ * @tparam T 生成する型
+ * @tparam Args コンストラクタ引数の型
+ * @param args コンストラクタに渡す引数
+ * @return Result<std::unique_ptr<T>, AllocError> 生成したオブジェクト
+ */
+template <typename T, typename... Args>
+Result<std::unique_ptr<T>, AllocError> try_make_unique(Args&&... args) {
+  auto p = try_new<T>(std::forward<Args>(args)...);
+  if (p.is_err()) {
+    return make_err(p.unwrap_err());
+  }
+  return make_ok(std::unique_ptr<T>(p.unwrap()));
+}
+
+/**
+ * @brief T型 n 個分の未初期化領域を確保し、失敗時はエラーを返す
+ * @tparam T 要素の型
+ * @param n 要素数
+ * @return Result<T*, AllocError> 確保した領域の先頭
+ *
+ * 解放には deallocate<T>() を使用してください。
+ */
+template <typename T>
+Result<T*, AllocError> try_allocate(std::size_t n) {
+  if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+    return make_err(AllocError::SizeOverflow);
+  }
+  void* p = nullptr;
+  if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    p = ::operator new(n * sizeof(T), std::align_val_t(alignof(T)),
+                       std::nothrow);
+  } else {
+    p = ::operator new(n * sizeof(T), std::nothrow);
+  }
+  if (!p) {
+    return make_err(AllocError::OutOfMemory);
+  }
+  return make_ok(static_cast<T*>(p));
+}
+
+/**
+ * @brief try_allocate<T>() で確保した領域を解放
+ * @tparam T 要素の型
+ * @param p 確保した領域の先頭
+ */
+template <typename T>
+void deallocate(T* p) {
+  if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    ::operator delete(p, std::align_val_t(alignof(T)));
+  } else {
+    ::operator delete(p);
+  }
+}
+
+/**
+ * @brief バンプアロケータ
+ *
+ * 固定長の領域から先頭に向かって順に切り出します。個別の解放はできず、
+ * reset() でまとめて解放します。リクエスト単位の一時領域などに使用します。
+ * 領域が不足した場合は AllocError::OutOfMemory を返します。
+ */
+class Arena final {
+ private:
+  std::byte* m_buffer = nullptr;
+  std::size_t m_capacity = 0;
+  std::size_t m_used = 0;
+  bool m_owned = false;
+
+  Arena(std::byte* buffer, std::size_t capacity, bool owned)
+      : m_buffer(buffer), m_capacity(capacity), m_owned(owned) {}
+
+ public:
+  /**
+   * @brief 外部の領域を使用するアリーナを生成
+   * @param buffer 使用する領域
+   * @param capacity 領域のバイト数
+   */
+  Arena(std::byte* buffer, std::size_t capacity)
+      : Arena(buffer, capacity, false) {}
+
+  /**
+   * @brief 指定サイズの領域を確保してアリーナを生成
+   * @param capacity 領域のバイト数
+   * @return Result<Arena, AllocError> 生成したアリーナ
+   */
+  static Result<Arena, AllocError> create(std::size_t capacity) {
+    auto buffer = try_allocate<std::byte>(capacity);
+    if (buffer.is_err()) {
+      return make_err(buffer.unwrap_err());
+    }
+    return make_ok(Arena(buffer.unwrap(), capacity, true));
+  }
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  Arena(Arena&& other)
+      : m_buffer(std::exchange(other.m_buffer, nullptr)),
+        m_capacity(std::exchange(other.m_capacity, 0)),
+        m_used(std::exchange(other.m_used, 0)),
+        m_owned(std::exchange(other.m_owned, false)) {}
+
+  Arena& operator=(Arena&& other) {
+    Arena(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  ~Arena() {
+    if (m_owned) {
+      deallocate(m_buffer);
+    }
+  }
+
+  void swap(Arena& other) {
+    using std::swap;
+    swap(m_buffer, other.m_buffer);
+    swap(m_capacity, other.m_capacity);
+    swap(m_used, other.m_used);
+    swap(m_owned, other.m_owned);
+  }
+
+  /**
+   * @brief 領域を切り出す
+   * @param size バイト数
+   * @param alignment アラインメント（2のべき乗）
+   * @return Result<MemoryBlock, AllocError> 切り出した領域
+   */
+  Result<MemoryBlock, AllocError> allocate(
+      std::size_t size,
+      std::size_t alignment = alignof(std::max_align_t)) {
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+    auto address = reinterpret_cast<std::uintptr_t>(m_buffer) + m_used;
+    std::size_t padding = (alignment - (address & (alignment - 1))) &
+                          (alignment - 1);
+    if (padding > m_capacity - m_used ||
+        size > m_capacity - m_used - padding) {
+      return make_err(AllocError::OutOfMemory);
+    }
+    std::byte* p = m_buffer + m_used + padding;
+    m_used += padding + size;
+    return make_ok(MemoryBlock{p, size});
+  }
+
+  /**
+   * @brief 領域を切り出してオブジェクトを構築
+   * @tparam T 構築する型（トリビアルに破棄可能であること）
+   * @tparam Args コンストラクタ引数の型
+   * @param args コンストラクタに渡す引数
+   * @return Result<T*, AllocError> 構築したオブジェクトへのポインタ
+   *
+   * デストラクタは呼び出されないため、トリビアルに破棄可能な型に限ります。
+   */
+  template <typename T, typename... Args>
+  Result<T*, AllocError> construct(Args&&... args) {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "T must be trivially destructible");
+    auto block = allocate(sizeof(T), alignof(T));
+    if (block.is_err()) {
+      return make_err(block.unwrap_err());
+    }
+    return make_ok(new (block.unchecked_ok().data())
+                       T(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief 切り出した領域をすべて解放
+   */
+  void reset() {
+    m_used = 0;
+  }
+
+  /**
+   * @brief 使用中のバイト数を取得
+   * @return std::size_t 使用中のバイト数
+   */
+  std::size_t used() const {
+    return m_used;
+  }
+
+  /**
+   * @brief 領域全体のバイト数を取得
+   * @return std::size_t 領域全体のバイト数
+   */
+  std::size_t capacity() const {
+    return m_capacity;
+  }
+};
+
+}  // namespace t9_result
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+#include "result.h"
+
+namespace t9_result {
+
+namespace detail {
+
+/**
+ * @brief Result をタグ1バイトとペイロードのバイト列に変換する
+ * @tparam T 成功値の型
+ * @tparam E 失敗値の型
+ */
+template <typename T, typename E>
+struct AtomicEncoding {
+  static constexpr std::size_t payload_size() {
+    if constexpr (std::is_void_v<T>) {
+      return sizeof(E);
+    } else {
+      return sizeof(T) > sizeof(E) ? sizeof(T) : sizeof(E);
+    }
+  }
+
+  static constexpr std::size_t kWords = (1 + payload_size() + 7) / 8;
+
+  static void encode(const Result<T, E>& result, std::uint64_t* words) {
+    unsigned char bytes[kWords * 8] = {};
+    if (result.is_ok()) {
+      bytes[0] = 1;
+      if constexpr (!std::is_void_v<T>) {
+        std::memcpy(bytes + 1, &result.unchecked_ok(), sizeof(T));
+      }
+    } else {
+      bytes[0] = 0;
+      std::memcpy(bytes + 1, &result.unchecked_err(), sizeof(E));
+    }
+    std::memcpy(words, bytes, sizeof(bytes));
+  }
+
+  // デフォルト構築できない型も扱えるよう、生の領域にコピーして読み出す
+  template <typename U>
+  static U load_value(const unsigned char* bytes) {
+    alignas(U) unsigned char storage[sizeof(U)];
+    std::memcpy(storage, bytes, sizeof(U));
+    return *std::launder(reinterpret_cast<const U*>(storage));
+  }
+
+  static Result<T, E> decode(const std::uint64_t* words) {
+    unsigned char bytes[kWords * 8];
+    std::memcpy(bytes, words, sizeof(bytes));
+    if (bytes[0] == 1) {
+      if constexpr (std::is_void_v<T>) {
+        return make_ok();
+      } else {
+        return Ok<T>(load_value<T>(bytes + 1));
+      }
+    }
+    return Err<E>(load_value<E>(bytes + 1));
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief スレッド間で最新の Result を公開するアトミック変数
+ * @tparam T 成功値の型（トリビアルコピー可能であること）
+ * @tparam E 失敗値の型（トリビアルコピー可能であること）
+ *
+ * ヘルスチェックや設定の再読み込みの結果のように、書き込みが少なく
+ * 多数のスレッドから読み込まれる値に使用します。
+ *
+ * タグとペイロードが8バイトに収まる場合は1つの std::atomic<uint64_t> に
+ * 格納し、読み書きともにロックフリーです。
+ * 収まらない場合はシーケンスロックで保護し、読み込み側は書き込みと
+ * 重なった場合のみ再試行します。読み込み側は共有変数に書き込まないため、
+ * 読み込みスレッドが増えてもキャッシュラインの競合は増えません。
+ */
+template <typename T, typename E>
+class AtomicResult final {
+  static_assert((std::is_void_v<T> || std::is_trivially_copyable_v<T>) &&
+                    std::is_trivially_copyable_v<E>,
+                "T and E must be trivially copyable");
+
+ private:
+  using Encoding = detail::AtomicEncoding<T, E>;
+  static constexpr std::size_t kWords = Encoding::kWords;
+
+  // kWords == 1 の場合は m_sequence を使用しない
+  std::atomic<std::uint32_t> m_sequence{0};
+  std::atomic<std::uint64_t> m_words[kWords];
+
+ public:
+  /// 読み書きが常にロックフリーか
+  static constexpr bool is_always_lock_free =
+      kWords == 1 && std::atomic<std::uint64_t>::is_always_lock_free;
+
+  /**
+   * @brief 初期値を指定して生成
+   * @param initial 初期値
+   */
+  explicit AtomicResult(const Result<T, E>& initial) {
+    std::uint64_t words[kWords];
+    Encoding::encode(initial, words);
+    for (std::size_t i = 0; i < kWords; ++i) {
+      m_words[i].store(words[i], std::memory_order_relaxed);
+    }
+  }
+
+  AtomicResult(const AtomicResult&) = delete;
+  AtomicResult& operator=(const AtomicResult&) = delete;
+
+  /**
+   * @brief 値を書き込む
+   * @param result 書き込むResult
+   *
+   * 複数のスレッドから同時に呼び出せます。
+   */
+  void store(const Result<T, E>& result) {
+    std::uint64_t words[kWords];
+    Encoding::encode(result, words);
+    if constexpr (kWords == 1) {
+      m_words[0].store(words[0], std::memory_order_release);
+    } else {
+      // シーケンス番号を奇数にして書き込み中であることを示す
+      std::uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+      for (;;) {
+        if ((sequence & 1) == 0 &&
+            m_sequence.compare_exchange_weak(sequence, sequence + 1,
+                                             std::memory_order_relaxed)) {
+          break;
+        }
+        sequence = m_sequence.load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_release);
+      for (std::size_t i = 0; i < kWords; ++i) {
+        m_words[i].store(words[i], std::memory_order_relaxed);
+      }
+      m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+  }
+
+  /**
+   * @brief 値を読み込む
+   * @return Result<T, E> 最後に書き込まれたResult
+   */
+  Result<T, E> load() const {
+    std::uint64_t words[kWords];
+    if constexpr (kWords == 1) {
+      words[0] = m_words[0].load(std::memory_order_acquire);
+    } else {
+      for (;;) {
+        std::uint32_t before = m_sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+          // 書き込み中のスレッドがプリエンプトされている可能性がある
+          std::this_thread::yield();
+          continue;
+        }
+        for (std::size_t i = 0; i < kWords; ++i) {
+          words[i] = m_words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_sequence.load(std::memory_order_relaxed) == before) {
+          break;
+        }
+      }
+    }
+    return Encoding::decode(words);
+  }
+};
+
+}  // namespace t9_result
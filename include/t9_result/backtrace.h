@@ -0,0 +1,286 @@
+#pragma once
+
+#if !defined(__linux__)
+#error "backtrace.h is only available on Linux"
+#endif
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <unwind.h>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "result.h"
+
+namespace t9_result {
+
+namespace detail {
+
+inline std::atomic<bool>& backtrace_enabled_flag() {
+  static std::atomic<bool> enabled{true};
+  return enabled;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Traced の生成時にバックトレースを取得するかを設定
+ * @param enabled 取得する場合true（既定値）
+ */
+inline void set_backtrace_enabled(bool enabled) {
+  detail::backtrace_enabled_flag().store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Traced の生成時にバックトレースを取得するか
+ * @return bool 取得する場合true
+ */
+inline bool backtrace_enabled() {
+  return detail::backtrace_enabled_flag().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief シンボル解決済みのスタックフレーム
+ */
+struct BacktraceFrame {
+  void* m_address;       ///< 戻りアドレス
+  const char* m_module;  ///< 共有オブジェクトのパス（不明な場合 nullptr）
+  const char* m_symbol;  ///< デマングル済みの関数名（不明な場合 nullptr）
+  std::uintptr_t m_offset;  ///< 関数名があれば関数、なければモジュールからの位置
+};
+
+/**
+ * @brief 戻りアドレスの列として保持するバックトレース
+ *
+ * capture() は _Unwind_Backtrace で戻りアドレスのみを最大 kMaxFrames 個
+ * 固定長の配列に記録し、ヒープ確保もシンボル解決も行いません。
+ * シンボル解決（dladdr とデマングル）は symbolize() や to_string() を
+ * 呼び出した時点で行います。
+ *
+ * 動的シンボル表に含まれない関数（static 関数や -rdynamic なしの
+ * 実行ファイル内の関数）は関数名を解決できないため、モジュールと
+ * その中での位置を出力します。addr2line などで解決できます。
+ */
+class Backtrace final {
+ public:
+  /// 記録する最大のフレーム数
+  static constexpr std::size_t kMaxFrames = 16;
+
+ private:
+  void* m_frames[kMaxFrames];
+  std::uint8_t m_size = 0;
+
+  struct UnwindState {
+    Backtrace* m_backtrace;
+    std::size_t m_skip;
+    std::uintptr_t m_anchor;  // このアドレスを含むフレームから記録（0 は無効）
+    void* m_previous;         // 直前のフレームの戻りアドレス
+  };
+
+  static _Unwind_Reason_Code on_frame(_Unwind_Context* context, void* arg) {
+    auto* state = static_cast<UnwindState*>(arg);
+    auto address = reinterpret_cast<void*>(_Unwind_GetIP(context));
+    if (!address) {
+      return _URC_END_OF_STACK;
+    }
+    Backtrace& backtrace = *state->m_backtrace;
+    if (state->m_anchor != 0) {
+      // この CFA は address を含む関数が呼び出した先のフレームのもの
+      // （address を含む関数のスタックの下端）。スタックは下位アドレスへ
+      // 伸びるため、これが起点を超えたら直前のフレームが起点を含む
+      if (_Unwind_GetCFA(context) > state->m_anchor) {
+        state->m_anchor = 0;
+        backtrace.m_size = 0;
+        backtrace.m_frames[backtrace.m_size++] = state->m_previous;
+      } else {
+        state->m_previous = address;
+      }
+    }
+    if (state->m_skip > 0) {
+      --state->m_skip;
+      return _URC_NO_REASON;
+    }
+    if (state->m_anchor != 0) {
+      // 起点を含むフレームが見つからない場合に備えて先頭から記録しておく
+      if (backtrace.m_size < kMaxFrames) {
+        backtrace.m_frames[backtrace.m_size++] = address;
+      }
+      return _URC_NO_REASON;
+    }
+    backtrace.m_frames[backtrace.m_size++] = address;
+    return backtrace.m_size == kMaxFrames ? _URC_END_OF_STACK
+                                          : _URC_NO_REASON;
+  }
+
+ public:
+  /**
+   * @brief 現在のスタックの戻りアドレスを記録
+   * @param skip 読み飛ばす呼び出し元のフレーム数
+   * @return Backtrace 記録したバックトレース
+   *
+   * 先頭のフレームは capture() の呼び出し元です。
+   */
+  __attribute__((noinline)) static Backtrace capture(std::size_t skip = 0) {
+    Backtrace backtrace;
+    // capture() 自身のフレームを除く
+    UnwindState state{&backtrace, skip + 1, 0, nullptr};
+    _Unwind_Backtrace(on_frame, &state);
+    return backtrace;
+  }
+
+  /**
+   * @brief スタック上のオブジェクトを含むフレームから戻りアドレスを記録
+   * @param object 呼び出し元のいずれかのフレームにあるオブジェクト
+   * @return Backtrace 記録したバックトレース
+   *
+   * 先頭のフレームは object をローカル変数や一時オブジェクトとして持つ
+   * 関数です。インライン展開の有無によってその間に挟まる関数の数が
+   * 変わっても、同じ関数から記録できます。object が現在のスレッドの
+   * スタック上にない場合は capture_from() の呼び出し元から記録します。
+   */
+  __attribute__((noinline)) static Backtrace capture_from(
+      const void* object) {
+    Backtrace backtrace;
+    UnwindState state{&backtrace, 1, 0, nullptr};
+    // 自身のフレームより下にあるオブジェクトは呼び出し元のものではない
+    auto anchor = reinterpret_cast<std::uintptr_t>(object);
+    if (anchor > reinterpret_cast<std::uintptr_t>(&state)) {
+      state.m_anchor = anchor;
+    }
+    _Unwind_Backtrace(on_frame, &state);
+    return backtrace;
+  }
+
+  std::size_t size() const {
+    return m_size;
+  }
+
+  bool empty() const {
+    return m_size == 0;
+  }
+
+  void* operator[](std::size_t index) const {
+    assert(index < m_size);
+    return m_frames[index];
+  }
+
+  /**
+   * @brief 各フレームのシンボルを解決して関数を適用
+   * @tparam F const BacktraceFrame& を受け取る関数の型
+   * @param f 適用する関数
+   *
+   * BacktraceFrame の文字列は f の呼び出し中のみ有効です。
+   */
+  template <typename F>
+  void symbolize(F&& f) const {
+    for (std::size_t i = 0; i < m_size; ++i) {
+      // 戻りアドレスは呼び出し命令の次を指すため、1つ前で解決する
+      void* address = m_frames[i];
+      auto lookup = reinterpret_cast<void*>(
+          reinterpret_cast<std::uintptr_t>(address) - 1);
+      BacktraceFrame frame{address, nullptr, nullptr, 0};
+      char* demangled = nullptr;
+      Dl_info info;
+      if (::dladdr(lookup, &info) != 0) {
+        frame.m_module = info.dli_fname;
+        if (info.dli_sname) {
+          int status = 0;
+          demangled =
+              abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+          frame.m_symbol = demangled ? demangled : info.dli_sname;
+          frame.m_offset = reinterpret_cast<std::uintptr_t>(address) -
+                           reinterpret_cast<std::uintptr_t>(info.dli_saddr);
+        } else {
+          frame.m_offset = reinterpret_cast<std::uintptr_t>(address) -
+                           reinterpret_cast<std::uintptr_t>(info.dli_fbase);
+        }
+      }
+      f(static_cast<const BacktraceFrame&>(frame));
+      std::free(demangled);
+    }
+  }
+
+  /**
+   * @brief シンボルを解決して1フレーム1行の文字列に変換
+   * @return std::string "#0 0x... 関数名+0x.. (モジュール)" 形式の文字列
+   */
+  std::string to_string() const {
+    std::string text;
+    std::size_t index = 0;
+    symbolize([&](const BacktraceFrame& frame) {
+      char line[64];
+      std::snprintf(line, sizeof(line), "#%zu %p ", index++, frame.m_address);
+      text += line;
+      if (frame.m_symbol) {
+        text += frame.m_symbol;
+      } else {
+        text += "??";
+      }
+      std::snprintf(line, sizeof(line), "+0x%zx",
+                    static_cast<std::size_t>(frame.m_offset));
+      text += line;
+      if (frame.m_module) {
+        text += " (";
+        text += frame.m_module;
+        text += ')';
+      }
+      text += '\n';
+    });
+    return text;
+  }
+};
+
+/**
+ * @brief 生成された位置のバックトレースを保持する失敗値
+ * @tparam E 失敗値の型
+ *
+ * Result<T, Traced<E>> として使用すると、make_err() や make_err_with()、
+ * Err<E> からの暗黙の変換で失敗値を生成した時点のバックトレースを
+ * 記録します。失敗値の型を変えずに使い分けられるよう、
+ * set_backtrace_enabled(false) で記録を止めることもできます。
+ *
+ * @code
+ * Result<Config, Traced<IoError>> load(const char* path) {
+ *   if (!exists(path)) {
+ *     return make_err(IoError::NotFound);  // ここのバックトレースを記録
+ *   }
+ *   ...
+ * }
+ * auto config = load(path);
+ * if (config.is_err()) {
+ *   std::fputs(config.ref_err().m_backtrace.to_string().c_str(), stderr);
+ * }
+ * @endcode
+ */
+template <typename E>
+struct Traced {
+  E m_error;
+  Backtrace m_backtrace;
+
+  /**
+   * @brief 失敗値を保持し、有効であればバックトレースを記録
+   * @param error 失敗値
+   */
+  template <typename U,
+            std::enable_if_t<!std::is_same_v<std::decay_t<U>, Traced> &&
+                                 std::is_constructible_v<E, U&&>,
+                             int> = 0>
+  Traced(U&& error) : m_error(std::forward<U>(error)) {
+    if (backtrace_enabled()) {
+      // Err や std::variant の内部を経由して呼ばれるため、その段数に
+      // よらず、変換元の失敗値を持つ関数（make_err() の呼び出し元）から記録する
+      m_backtrace = Backtrace::capture_from(std::addressof(error));
+    }
+  }
+};
+
+}  // namespace t9_result
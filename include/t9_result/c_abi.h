@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "c_result.h"
+#include "result.h"
+
+namespace t9_result {
+
+/**
+ * @brief 成功値の型に対応する C の構造体を定義するトレイト
+ * @tparam T 成功値の型
+ *
+ * void は t9_status、std::int32_t / std::int64_t / std::uint64_t / double は
+ * t9_result_i32 / t9_result_i64 / t9_result_u64 / t9_result_f64、
+ * ポインタは t9_result_ptr に対応します。
+ */
+template <typename T, typename = void>
+struct CResultOf;
+
+template <>
+struct CResultOf<void> {
+  using type = t9_status;
+};
+
+template <>
+struct CResultOf<std::int32_t> {
+  using type = t9_result_i32;
+};
+
+template <>
+struct CResultOf<std::int64_t> {
+  using type = t9_result_i64;
+};
+
+template <>
+struct CResultOf<std::uint64_t> {
+  using type = t9_result_u64;
+};
+
+template <>
+struct CResultOf<double> {
+  using type = t9_result_f64;
+};
+
+template <typename T>
+struct CResultOf<T*> {
+  using type = t9_result_ptr;
+};
+
+template <typename T>
+using c_result_t = typename CResultOf<T>::type;
+
+namespace detail {
+
+template <typename C>
+constexpr bool is_c_result_layout_v =
+    std::is_standard_layout_v<C> && std::is_trivially_copyable_v<C> &&
+    sizeof(C) <= 16;
+
+static_assert(is_c_result_layout_v<t9_status> &&
+              is_c_result_layout_v<t9_result_i32> &&
+              is_c_result_layout_v<t9_result_i64> &&
+              is_c_result_layout_v<t9_result_u64> &&
+              is_c_result_layout_v<t9_result_f64> &&
+              is_c_result_layout_v<t9_result_ptr>);
+static_assert(offsetof(t9_result_i64, error) == 8 &&
+              sizeof(t9_result_i64) == 16);
+
+template <typename E>
+constexpr bool is_c_error_v =
+    (std::is_enum_v<E> || std::is_integral_v<E>) && sizeof(E) <= 4;
+
+}  // namespace detail
+
+/**
+ * @brief Result を C の構造体に変換
+ * @tparam T 成功値の型（CResultOf が定義されていること）
+ * @tparam E 失敗値の型（4バイト以下の列挙型または整数型）
+ * @param result 変換元
+ * @return c_result_t<T> 変換した構造体
+ * @note 失敗値が T9_OK（0）の場合はアサーション違反
+ */
+template <typename T, typename E>
+c_result_t<T> to_c(const Result<T, E>& result) {
+  static_assert(detail::is_c_error_v<E>,
+                "E must be an enum or integer of at most 4 bytes");
+  c_result_t<T> c{};
+  if (result.is_ok()) {
+    if constexpr (!std::is_void_v<T>) {
+      if constexpr (std::is_pointer_v<T>) {
+        c.value = const_cast<void*>(
+            static_cast<const volatile void*>(result.unchecked_ok()));
+      } else {
+        c.value = result.unchecked_ok();
+      }
+    }
+    c.error = T9_OK;
+  } else {
+    c.error = static_cast<std::int32_t>(result.unchecked_err());
+    assert(c.error != T9_OK);
+  }
+  return c;
+}
+
+/**
+ * @brief C の構造体を Result に変換
+ * @tparam T 成功値の型
+ * @tparam E 失敗値の型
+ * @param c 変換元
+ * @return Result<T, E> 変換したResult
+ */
+template <typename T, typename E>
+Result<T, E> from_c(const c_result_t<T>& c) {
+  static_assert(detail::is_c_error_v<E>,
+                "E must be an enum or integer of at most 4 bytes");
+  if (c.error != T9_OK) {
+    return Err<E>(static_cast<E>(c.error));
+  }
+  if constexpr (std::is_void_v<T>) {
+    return make_ok();
+  } else if constexpr (std::is_pointer_v<T>) {
+    return Ok<T>(static_cast<T>(c.value));
+  } else {
+    return Ok<T>(c.value);
+  }
+}
+
+}  // namespace t9_result
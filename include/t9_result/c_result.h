@@ -0,0 +1,59 @@
+/**
+ * @file c_result.h
+ * @brief C や FFI から Result を受け渡すための構造体
+ *
+ * C と C++ のどちらからもインクルードできます。各構造体は成功値と
+ * エラーコードのみを持つ標準レイアウトの型で、16バイト以下のため
+ * x86_64 SysV / AArch64 ではレジスタで返されます。
+ *
+ * error が T9_OK（0）の場合は成功で value が有効です。
+ * それ以外の場合は失敗で、value の内容は未規定です。
+ * C++ 側の変換は c_abi.h の to_c() / from_c() を使用します。
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 成功を表すエラーコード */
+#define T9_OK 0
+
+/** 成功値を持たない結果 */
+typedef struct t9_status {
+  int32_t error;
+} t9_status;
+
+typedef struct t9_result_i32 {
+  int32_t value;
+  int32_t error;
+} t9_result_i32;
+
+typedef struct t9_result_i64 {
+  int64_t value;
+  int32_t error;
+} t9_result_i64;
+
+typedef struct t9_result_u64 {
+  uint64_t value;
+  int32_t error;
+} t9_result_u64;
+
+typedef struct t9_result_f64 {
+  double value;
+  int32_t error;
+} t9_result_f64;
+
+typedef struct t9_result_ptr {
+  void* value;
+  int32_t error;
+} t9_result_ptr;
+
+/** 結果が成功か確認（すべての t9_status / t9_result_* に使用可能） */
+#define T9_IS_OK(result) ((result).error == T9_OK)
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,462 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "result.h"
+
+namespace t9_result {
+
+/**
+ * @brief 整数演算のエラー
+ */
+enum class ArithError {
+  Overflow,        ///< 結果が型の範囲を超える
+  DivisionByZero,  ///< 0 による除算
+  OutOfRange,      ///< 変換先の型で表せない値
+};
+
+/**
+ * @brief 配列に対する演算のエラー
+ */
+struct BatchError {
+  ArithError m_error;   ///< エラーの種類
+  std::size_t m_index;  ///< 最初に失敗した要素の位置
+};
+
+namespace detail {
+
+template <typename T>
+constexpr bool is_checked_integer_v =
+    std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+template <typename T>
+bool add_overflow(T a, T b, T* result) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_add_overflow(a, b, result);
+#else
+  using U = std::make_unsigned_t<T>;
+  T r = static_cast<T>(static_cast<U>(a) + static_cast<U>(b));
+  *result = r;
+  if constexpr (std::is_signed_v<T>) {
+    return ((a ^ r) & (b ^ r)) < 0;
+  } else {
+    return r < a;
+  }
+#endif
+}
+
+template <typename T>
+bool sub_overflow(T a, T b, T* result) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_sub_overflow(a, b, result);
+#else
+  using U = std::make_unsigned_t<T>;
+  T r = static_cast<T>(static_cast<U>(a) - static_cast<U>(b));
+  *result = r;
+  if constexpr (std::is_signed_v<T>) {
+    return ((a ^ b) & (a ^ r)) < 0;
+  } else {
+    return a < b;
+  }
+#endif
+}
+
+template <typename T>
+bool mul_overflow(T a, T b, T* result) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_mul_overflow(a, b, result);
+#else
+  if constexpr (sizeof(T) < 8) {
+    using W = std::conditional_t<std::is_signed_v<T>, std::int64_t,
+                                 std::uint64_t>;
+    W wide = static_cast<W>(a) * static_cast<W>(b);
+    *result = static_cast<T>(wide);
+    return wide != static_cast<W>(*result);
+  } else {
+    using U = std::make_unsigned_t<T>;
+    *result = static_cast<T>(static_cast<U>(a) * static_cast<U>(b));
+    if (a == 0 || b == 0) {
+      return false;
+    }
+    if constexpr (std::is_signed_v<T>) {
+      if ((a == -1 && b == std::numeric_limits<T>::min()) ||
+          (b == -1 && a == std::numeric_limits<T>::min())) {
+        return true;
+      }
+    }
+    return *result / b != a;
+  }
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * @brief オーバーフローを検査する加算
+ * @tparam T 整数型
+ * @return Result<T, ArithError> 範囲を超える場合は ArithError::Overflow
+ */
+template <typename T>
+Result<T, ArithError> checked_add(T a, T b) {
+  static_assert(detail::is_checked_integer_v<T>, "T must be an integer");
+  T result;
+  if (detail::add_overflow(a, b, &result)) {
+    return make_err(ArithError::Overflow);
+  }
+  return make_ok(result);
+}
+
+/**
+ * @brief オーバーフローを検査する減算
+ * @tparam T 整数型
+ * @return Result<T, ArithError> 範囲を超える場合は ArithError::Overflow
+ */
+template <typename T>
+Result<T, ArithError> checked_sub(T a, T b) {
+  static_assert(detail::is_checked_integer_v<T>, "T must be an integer");
+  T result;
+  if (detail::sub_overflow(a, b, &result)) {
+    return make_err(ArithError::Overflow);
+  }
+  return make_ok(result);
+}
+
+/**
+ * @brief オーバーフローを検査する乗算
+ * @tparam T 整数型
+ * @return Result<T, ArithError> 範囲を超える場合は ArithError::Overflow
+ */
+template <typename T>
+Result<T, ArithError> checked_mul(T a, T b) {
+  static_assert(detail::is_checked_integer_v<T>, "T must be an integer");
+  T result;
+  if (detail::mul_overflow(a, b, &result)) {
+    return make_err(ArithError::Overflow);
+  }
+  return make_ok(result);
+}
+
+/**
+ * @brief 0 除算とオーバーフローを検査する除算
+ * @tparam T 整数型
+ * @return Result<T, ArithError> b が 0 の場合は ArithError::DivisionByZero、
+ *         最小値を -1 で割る場合は ArithError::Overflow
+ */
+template <typename T>
+Result<T, ArithError> checked_div(T a, T b) {
+  static_assert(detail::is_checked_integer_v<T>, "T must be an integer");
+  if (b == 0) {
+    return make_err(ArithError::DivisionByZero);
+  }
+  if constexpr (std::is_signed_v<T>) {
+    if (a == std::numeric_limits<T>::min() && b == -1) {
+      return make_err(ArithError::Overflow);
+    }
+  }
+  return make_ok(static_cast<T>(a / b));
+}
+
+/**
+ * @brief 値を変えずに変換できる場合のみ整数型を変換
+ * @tparam To 変換先の整数型
+ * @tparam From 変換元の整数型
+ * @param value 変換元の値
+ * @return Result<To, ArithError> 表せない場合は ArithError::OutOfRange
+ */
+template <typename To, typename From>
+Result<To, ArithError> checked_cast(From value) {
+  static_assert(detail::is_checked_integer_v<To> &&
+                    detail::is_checked_integer_v<From>,
+                "To and From must be integers");
+  using ToLimits = std::numeric_limits<To>;
+  using FromLimits = std::numeric_limits<From>;
+  constexpr bool kFromSigned = std::is_signed_v<From>;
+  constexpr bool kToSigned = std::is_signed_v<To>;
+
+  if constexpr (kFromSigned == kToSigned &&
+                FromLimits::digits <= ToLimits::digits) {
+    // 同じ符号で広がる変換は常に成功する
+  } else if constexpr (!kFromSigned && kToSigned &&
+                       FromLimits::digits <= ToLimits::digits) {
+    // 符号なしから、より広い符号付きへの変換も常に成功する
+  } else if constexpr (kFromSigned && kToSigned) {
+    if (value < static_cast<From>(ToLimits::min()) ||
+        value > static_cast<From>(ToLimits::max())) {
+      return make_err(ArithError::OutOfRange);
+    }
+  } else if constexpr (kFromSigned) {
+    // 符号付きから符号なしへ
+    if (value < 0) {
+      return make_err(ArithError::OutOfRange);
+    }
+    if constexpr (FromLimits::digits > ToLimits::digits) {
+      if (value > static_cast<From>(ToLimits::max())) {
+        return make_err(ArithError::OutOfRange);
+      }
+    }
+  } else {
+    // 符号なしから、同じかより狭い型へ
+    if (value > static_cast<From>(ToLimits::max())) {
+      return make_err(ArithError::OutOfRange);
+    }
+  }
+  return make_ok(static_cast<To>(value));
+}
+
+namespace detail {
+
+// 配列演算は kBatchBlock 要素ごとに、結果の計算とオーバーフローの判定を
+// 分岐なしで行い（ベクトル化できる形）、ブロックの末尾でのみ判定結果を
+// 検査する。失敗したブロックのみスカラーの演算で最初の位置を探す。
+constexpr std::size_t kBatchBlock = 256;
+
+template <typename T>
+struct BatchAdd {
+  // 戻り値は結果、flag はオーバーフローした場合に0以外になる
+  static T apply(T a, T b, T& flag) {
+    using U = std::make_unsigned_t<T>;
+    T r = static_cast<T>(static_cast<U>(a) + static_cast<U>(b));
+    if constexpr (std::is_signed_v<T>) {
+      flag = static_cast<T>(flag | ((a ^ r) & (b ^ r)));
+    } else {
+      flag = static_cast<T>(flag | static_cast<T>(r < a));
+    }
+    return r;
+  }
+
+  static bool failed(T flag) {
+    if constexpr (std::is_signed_v<T>) {
+      return flag < 0;
+    } else {
+      return flag != 0;
+    }
+  }
+
+  static Result<T, ArithError> checked(T a, T b) {
+    return checked_add(a, b);
+  }
+};
+
+template <typename T>
+struct BatchSub {
+  static T apply(T a, T b, T& flag) {
+    using U = std::make_unsigned_t<T>;
+    T r = static_cast<T>(static_cast<U>(a) - static_cast<U>(b));
+    if constexpr (std::is_signed_v<T>) {
+      flag = static_cast<T>(flag | ((a ^ b) & (a ^ r)));
+    } else {
+      flag = static_cast<T>(flag | static_cast<T>(a < b));
+    }
+    return r;
+  }
+
+  static bool failed(T flag) {
+    return BatchAdd<T>::failed(flag);
+  }
+
+  static Result<T, ArithError> checked(T a, T b) {
+    return checked_sub(a, b);
+  }
+};
+
+// 16ビット以下の型のみ（32ビットに広げて計算し、元の型に収まるかを比較する）
+template <typename T>
+struct BatchMul {
+  static_assert(sizeof(T) < 4);
+
+  static T apply(T a, T b, T& flag) {
+    using W = std::conditional_t<std::is_signed_v<T>, std::int32_t,
+                                 std::uint32_t>;
+    W wide = static_cast<W>(a) * static_cast<W>(b);
+    T r = static_cast<T>(wide);
+    flag = static_cast<T>(flag | static_cast<T>(static_cast<W>(r) != wide));
+    return r;
+  }
+
+  static bool failed(T flag) {
+    return flag != 0;
+  }
+
+  static Result<T, ArithError> checked(T a, T b) {
+    return checked_mul(a, b);
+  }
+};
+
+template <typename Op, typename T>
+Result<void, BatchError> batch_apply(const T* a, const T* b, T* out,
+                                     std::size_t n) {
+  // out が a や b と重なっていても失敗時に入力を読み直せるよう、
+  // ブロックの結果は一時領域に書き込む
+  T block[kBatchBlock];
+  for (std::size_t begin = 0; begin < n; begin += kBatchBlock) {
+    std::size_t size = n - begin < kBatchBlock ? n - begin : kBatchBlock;
+    const T* x = a + begin;
+    const T* y = b + begin;
+    T flag = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      block[i] = Op::apply(x[i], y[i], flag);
+    }
+    if (Op::failed(flag)) {
+      for (std::size_t i = 0; i < size; ++i) {
+        auto result = Op::checked(x[i], y[i]);
+        if (result.is_err()) {
+          return make_err(BatchError{result.unchecked_err(), begin + i});
+        }
+        out[begin + i] = result.unchecked_ok();
+      }
+    }
+    std::memcpy(out + begin, block, size * sizeof(T));
+  }
+  return make_ok();
+}
+
+// 変換先で表せない場合に0以外になる値（シフトと加算のみで判定する）
+template <typename To, typename From>
+std::make_unsigned_t<From> cast_flag(From value) {
+  using U = std::make_unsigned_t<From>;
+  constexpr int kFromBits = static_cast<int>(sizeof(From)) * 8;
+  constexpr int kToDigits = std::numeric_limits<To>::digits;
+  auto bits = static_cast<U>(value);
+  if constexpr (std::is_signed_v<From> && std::is_signed_v<To>) {
+    if constexpr (kToDigits + 1 >= kFromBits) {
+      return 0;
+    } else {
+      // [min, max] を [0, 2^(kToDigits+1)) に移す
+      // （int より狭い型は汎整数昇格で桁あふれしないため U に戻してからシフト）
+      auto shifted = static_cast<U>(bits + (U{1} << kToDigits));
+      return static_cast<U>(shifted >> (kToDigits + 1));
+    }
+  } else if constexpr (std::is_signed_v<From>) {
+    // 負の値は最上位ビットが立つ
+    return kToDigits >= kFromBits - 1
+               ? static_cast<U>(bits >> (kFromBits - 1))
+               : static_cast<U>(bits >> kToDigits);
+  } else if constexpr (kToDigits >= kFromBits) {
+    return 0;
+  } else {
+    return static_cast<U>(bits >> kToDigits);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief 配列の要素ごとにオーバーフローを検査する加算
+ * @tparam T 整数型
+ * @param a 左辺の配列
+ * @param b 右辺の配列
+ * @param out 結果の配列（a や b と同じでもよい）
+ * @param n 要素数
+ * @return Result<void, BatchError> 失敗した場合は最初に失敗した位置
+ *
+ * 失敗した場合、out の最初に失敗した位置より前の要素は計算済みで、
+ * それ以降の要素は変更しません。
+ */
+template <typename T>
+Result<void, BatchError> checked_add_n(const T* a, const T* b, T* out,
+                                       std::size_t n) {
+  static_assert(detail::is_checked_integer_v<T>, "T must be an integer");
+  return detail::batch_apply<detail::BatchAdd<T>>(a, b, out, n);
+}
+
+/**
+ * @brief 配列の要素ごとにオーバーフローを検査する減算
+ * @see checked_add_n()
+ */
+template <typename T>
+Result<void, BatchError> checked_sub_n(const T* a, const T* b, T* out,
+                                       std::size_t n) {
+  static_assert(detail::is_checked_integer_v<T>, "T must be an integer");
+  return detail::batch_apply<detail::BatchSub<T>>(a, b, out, n);
+}
+
+/**
+ * @brief 配列の要素ごとにオーバーフローを検査する乗算
+ * @see checked_add_n()
+ *
+ * 16ビット以下の型は32ビットに広げて判定するためベクトル化できます。
+ * 32ビット以上の型は広げた乗算のベクトル命令が SSE2 にないため、
+ * 要素ごとに判定し、最初の失敗で終了します。
+ */
+template <typename T>
+Result<void, BatchError> checked_mul_n(const T* a, const T* b, T* out,
+                                       std::size_t n) {
+  static_assert(detail::is_checked_integer_v<T>, "T must be an integer");
+  if constexpr (sizeof(T) < 4) {
+    return detail::batch_apply<detail::BatchMul<T>>(a, b, out, n);
+  } else {
+    for (std::size_t i = 0; i < n; ++i) {
+      // 失敗した位置の out を変更しないよう、一時変数に計算する
+      T product;
+      if (detail::mul_overflow(a[i], b[i], &product)) {
+        return make_err(BatchError{ArithError::Overflow, i});
+      }
+      out[i] = product;
+    }
+    return make_ok();
+  }
+}
+
+/**
+ * @brief 配列の要素ごとに検査する除算
+ * @see checked_add_n()
+ *
+ * 整数の除算はベクトル化できないため、要素ごとに checked_div() を
+ * 適用し、最初の失敗で終了します。
+ */
+template <typename T>
+Result<void, BatchError> checked_div_n(const T* a, const T* b, T* out,
+                                       std::size_t n) {
+  static_assert(detail::is_checked_integer_v<T>, "T must be an integer");
+  for (std::size_t i = 0; i < n; ++i) {
+    auto result = checked_div(a[i], b[i]);
+    if (result.is_err()) {
+      return make_err(BatchError{result.unchecked_err(), i});
+    }
+    out[i] = result.unchecked_ok();
+  }
+  return make_ok();
+}
+
+/**
+ * @brief 配列の要素ごとに値を変えずに変換できるか検査して変換
+ * @tparam To 変換先の整数型
+ * @tparam From 変換元の整数型
+ * @param in 変換元の配列
+ * @param out 変換先の配列
+ * @param n 要素数
+ * @return Result<void, BatchError> 失敗した場合は最初に失敗した位置
+ *
+ * 判定はシフトと加算のみで行うためベクトル化できます。
+ * 失敗した場合、out の内容は未規定です。
+ */
+template <typename To, typename From>
+Result<void, BatchError> checked_cast_n(const From* in, To* out,
+                                        std::size_t n) {
+  static_assert(detail::is_checked_integer_v<To> &&
+                    detail::is_checked_integer_v<From>,
+                "To and From must be integers");
+  for (std::size_t begin = 0; begin < n; begin += detail::kBatchBlock) {
+    std::size_t size =
+        n - begin < detail::kBatchBlock ? n - begin : detail::kBatchBlock;
+    std::make_unsigned_t<From> flag = 0;
+    for (std::size_t i = begin; i < begin + size; ++i) {
+      flag |= detail::cast_flag<To>(in[i]);
+      out[i] = static_cast<To>(in[i]);
+    }
+    if (flag != 0) {
+      for (std::size_t i = begin; i < begin + size; ++i) {
+        if (checked_cast<To>(in[i]).is_err()) {
+          return make_err(BatchError{ArithError::OutOfRange, i});
+        }
+      }
+    }
+  }
+  return make_ok();
+}
+
+}  // namespace t9_result
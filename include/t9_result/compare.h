@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+#if defined(__cpp_lib_three_way_comparison)
+#include <compare>
+#endif
+
+#include "result.h"
+
+/**
+ * @file compare.h
+ * @brief Result の比較演算子と std::hash の特殊化
+ *
+ * 成功値同士・失敗値同士は値で比較し、成功値は失敗値より小さいものとして
+ * 順序付けます。
+ */
+
+namespace t9_result {
+
+/**
+ * @brief バイト列として比較・ハッシュできる型かを表すトレイト
+ * @tparam T 対象の型
+ *
+ * true の型は operator== の代わりにオブジェクト表現を直接比較し、
+ * std::hash の代わりにバイト列からハッシュ値を計算します。
+ * 既定では、パディングを持たないトリビアルコピー可能なスカラー型
+ * （整数・列挙型・ポインタ）が該当します。
+ *
+ * 構造体はメンバごとの operator== と一致する保証がないため既定では
+ * 対象外です。パディングを持たず、等価性がバイト列の一致と同じである
+ * 構造体は、このテンプレートを特殊化して有効にできます。
+ */
+template <typename T, typename = void>
+struct BitwiseComparable {
+  static constexpr bool value = std::is_scalar_v<T> &&
+                                std::has_unique_object_representations_v<T>;
+};
+
+namespace detail {
+
+template <typename T>
+constexpr bool is_bitwise_comparable_v =
+    BitwiseComparable<T>::value && std::is_trivially_copyable_v<T> &&
+    std::has_unique_object_representations_v<T>;
+
+template <typename T>
+bool payload_equal(const T& a, const T& b) {
+  if constexpr (is_bitwise_comparable_v<T>) {
+    return std::memcmp(&a, &b, sizeof(T)) == 0;
+  } else {
+    return a == b;
+  }
+}
+
+inline std::size_t mix_hash_word(std::size_t seed, std::uint64_t word) {
+  std::uint64_t h = (seed ^ word) * 0x9E3779B97F4A7C15ull;
+  return static_cast<std::size_t>(h ^ (h >> 32));
+}
+
+template <typename T>
+std::size_t payload_hash(std::size_t seed, const T& value) {
+  if constexpr (is_bitwise_comparable_v<T>) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+    std::size_t offset = 0;
+    for (; offset + 8 <= sizeof(T); offset += 8) {
+      std::uint64_t word;
+      std::memcpy(&word, bytes + offset, 8);
+      seed = mix_hash_word(seed, word);
+    }
+    if (offset < sizeof(T)) {
+      std::uint64_t word = 0;
+      std::memcpy(&word, bytes + offset, sizeof(T) - offset);
+      seed = mix_hash_word(seed, word);
+    }
+    return seed;
+  } else {
+    return mix_hash_word(seed, std::hash<T>{}(value));
+  }
+}
+
+// ハッシュ値の初期値（成功と失敗で異なる値にする）
+constexpr std::size_t kHashSeedOk = 0x51ED27;
+constexpr std::size_t kHashSeedErr = 0xE3B1A9;
+
+}  // namespace detail
+
+/**
+ * @brief 2つのResultが等しいか比較
+ * @return bool 同じ側の値を保持し、その値が等しい場合true
+ */
+template <typename T, typename E>
+bool operator==(const Result<T, E>& a, const Result<T, E>& b) {
+  if (a.is_ok() != b.is_ok()) {
+    return false;
+  }
+  if (a.is_ok()) {
+    if constexpr (std::is_void_v<T>) {
+      return true;
+    } else {
+      return detail::payload_equal<std::remove_reference_t<T>>(
+          a.unchecked_ok(), b.unchecked_ok());
+    }
+  }
+  return detail::payload_equal(a.unchecked_err(), b.unchecked_err());
+}
+
+template <typename T, typename E>
+bool operator!=(const Result<T, E>& a, const Result<T, E>& b) {
+  return !(a == b);
+}
+
+/**
+ * @brief 2つのResultの順序を比較
+ * @return bool a が b より小さい場合true
+ *
+ * 成功値は失敗値より小さく、同じ側同士は保持する値の operator< で比較します。
+ */
+template <typename T, typename E>
+bool operator<(const Result<T, E>& a, const Result<T, E>& b) {
+  if (a.is_ok() != b.is_ok()) {
+    return a.is_ok();
+  }
+  if (a.is_ok()) {
+    if constexpr (std::is_void_v<T>) {
+      return false;
+    } else {
+      return a.unchecked_ok() < b.unchecked_ok();
+    }
+  }
+  return a.unchecked_err() < b.unchecked_err();
+}
+
+template <typename T, typename E>
+bool operator>(const Result<T, E>& a, const Result<T, E>& b) {
+  return b < a;
+}
+
+template <typename T, typename E>
+bool operator<=(const Result<T, E>& a, const Result<T, E>& b) {
+  return !(b < a);
+}
+
+template <typename T, typename E>
+bool operator>=(const Result<T, E>& a, const Result<T, E>& b) {
+  return !(a < b);
+}
+
+#if defined(__cpp_lib_three_way_comparison)
+
+/**
+ * @brief 2つのResultを三方比較（C++20）
+ * @return 成功値は失敗値より小さいものとした比較結果
+ */
+template <typename T, typename E>
+  requires(std::is_void_v<T> || std::three_way_comparable<T>) &&
+          std::three_way_comparable<E>
+auto operator<=>(const Result<T, E>& a, const Result<T, E>& b) {
+  // void の場合は strong_ordering になるよう int で代用する
+  using OkOrdering = std::compare_three_way_result_t<
+      std::conditional_t<std::is_void_v<T>, int, T>>;
+  using Ordering = std::common_comparison_category_t<
+      OkOrdering, std::compare_three_way_result_t<E>>;
+  if (a.is_ok() != b.is_ok()) {
+    return Ordering(a.is_ok() ? std::strong_ordering::less
+                              : std::strong_ordering::greater);
+  }
+  if (a.is_ok()) {
+    if constexpr (std::is_void_v<T>) {
+      return Ordering(std::strong_ordering::equal);
+    } else {
+      return Ordering(a.unchecked_ok() <=> b.unchecked_ok());
+    }
+  }
+  return Ordering(a.unchecked_err() <=> b.unchecked_err());
+}
+
+#endif
+
+}  // namespace t9_result
+
+namespace std {
+
+/**
+ * @brief Result の std::hash 特殊化
+ *
+ * 成功・失敗の区別と保持する値からハッシュ値を計算します。
+ * BitwiseComparable な値はオブジェクト表現から直接計算します。
+ */
+template <typename T, typename E>
+struct hash<t9_result::Result<T, E>> {
+  std::size_t operator()(const t9_result::Result<T, E>& result) const {
+    namespace d = t9_result::detail;
+    if (result.is_ok()) {
+      if constexpr (std::is_void_v<T>) {
+        return d::kHashSeedOk;
+      } else {
+        return d::payload_hash<std::remove_reference_t<T>>(
+            d::kHashSeedOk, result.unchecked_ok());
+      }
+    }
+    return d::payload_hash(d::kHashSeedErr, result.unchecked_err());
+  }
+};
+
+}  // namespace std
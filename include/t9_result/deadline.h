@@ -0,0 +1,263 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "result.h"
+
+namespace t9_result {
+
+/**
+ * @brief 期限切れを表す失敗値
+ *
+ * Result<T, OneOf<Timeout, E>> のように他の失敗値と組み合わせると、
+ * within() で期限を伝播できます。
+ */
+struct Timeout {
+  friend bool operator==(Timeout, Timeout) {
+    return true;
+  }
+
+  friend bool operator!=(Timeout, Timeout) {
+    return false;
+  }
+};
+
+/**
+ * @brief steady_clock 上の絶対時刻で表す期限
+ *
+ * 相対的なタイムアウトではなく絶対時刻を受け渡すことで、
+ * 複数の待機を経由しても全体の期限が延びません。
+ * never() は期限なしを表し、expired() は常にfalseです。
+ */
+class Deadline final {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+ private:
+  Clock::time_point m_time;
+
+ public:
+  /**
+   * @brief 絶対時刻から生成
+   * @param time 期限の時刻
+   */
+  explicit Deadline(Clock::time_point time) : m_time(time) {}
+
+  /**
+   * @brief 期限なしを生成
+   * @return Deadline 期限切れにならない期限
+   */
+  static Deadline never() {
+    return Deadline(Clock::time_point::max());
+  }
+
+  /**
+   * @brief 現在時刻から指定した時間後の期限を生成
+   * @param timeout 現在時刻からの時間（表せない長さの場合は期限なし）
+   * @return Deadline 生成した期限
+   */
+  template <typename Rep, typename Period>
+  static Deadline after(std::chrono::duration<Rep, Period> timeout) {
+    using Seconds = std::chrono::duration<double>;
+    auto now = Clock::now();
+    // 単位や表現の型が異なってもオーバーフローしないよう浮動小数点で比較する
+    if (Seconds(timeout) >= Seconds(Clock::time_point::max() - now)) {
+      return never();
+    }
+    return Deadline(now + std::chrono::ceil<Clock::duration>(timeout));
+  }
+
+  Clock::time_point time() const {
+    return m_time;
+  }
+
+  bool is_never() const {
+    return m_time == Clock::time_point::max();
+  }
+
+  /**
+   * @brief 期限を過ぎたか確認
+   * @param now 現在時刻
+   * @return bool 期限を過ぎた場合true
+   */
+  bool expired(Clock::time_point now = Clock::now()) const {
+    return !is_never() && now >= m_time;
+  }
+
+  /**
+   * @brief 期限までの残り時間を取得
+   * @param now 現在時刻
+   * @return Clock::duration 残り時間（過ぎている場合は0、期限なしは最大値）
+   */
+  Clock::duration remaining(Clock::time_point now = Clock::now()) const {
+    if (is_never()) {
+      return Clock::duration::max();
+    }
+    return now >= m_time ? Clock::duration::zero() : m_time - now;
+  }
+
+  /**
+   * @brief 期限を過ぎていないか検査
+   * @return Result<void, Timeout> 過ぎている場合は Timeout
+   */
+  Result<void, Timeout> check() const {
+    if (expired()) {
+      return make_err(Timeout{});
+    }
+    return make_ok();
+  }
+
+  /**
+   * @brief 早い方の期限を取得
+   * @param other 比較する期限
+   * @return Deadline 早い方の期限
+   */
+  Deadline earliest(Deadline other) const {
+    return other.m_time < m_time ? other : *this;
+  }
+
+  friend bool operator==(Deadline a, Deadline b) {
+    return a.m_time == b.m_time;
+  }
+
+  friend bool operator!=(Deadline a, Deadline b) {
+    return a.m_time != b.m_time;
+  }
+
+  friend bool operator<(Deadline a, Deadline b) {
+    return a.m_time < b.m_time;
+  }
+};
+
+namespace detail {
+
+template <typename F, typename... Args>
+auto invoke_within(F& f, Deadline deadline, Args&&... args) {
+  if constexpr (std::is_invocable_v<F&, Args&&..., Deadline>) {
+    return f(std::forward<Args>(args)..., deadline);
+  } else {
+    return f(std::forward<Args>(args)...);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief 期限を過ぎていれば呼び出さずに Timeout を返す関数オブジェクトを生成
+ * @tparam F Result を返す関数の型
+ * @param deadline 期限
+ * @param f 呼び出す関数（最後の引数で Deadline を受け取れる場合は渡します）
+ * @return 元の引数を受け取り、f と同じ型の Result を返す関数オブジェクト
+ *
+ * and_then() の各段に渡すことで、チェーン全体で1つの期限を共有します。
+ * 期限切れの段以降は呼び出されず、Timeout がそのまま伝播します。
+ * f の失敗値の型は Timeout から暗黙に変換できる必要があります。
+ *
+ * @code
+ * auto deadline = Deadline::after(std::chrono::milliseconds(50));
+ * Result<Reply, OneOf<Timeout, IoError>> reply =
+ *     connect(host, deadline)
+ *         .and_then(within(deadline, send_request))  // (Socket&, Deadline)
+ *         .and_then(within(deadline, parse_reply));  // (Bytes&)
+ * @endcode
+ */
+template <typename F>
+auto within(Deadline deadline, F f) {
+  return [deadline, f = std::move(f)](auto&&... args) mutable {
+    using R = decltype(detail::invoke_within(
+        f, deadline, std::forward<decltype(args)>(args)...));
+    if (deadline.expired()) {
+      return R(make_err(Timeout{}));
+    }
+    return detail::invoke_within(f, deadline,
+                                 std::forward<decltype(args)>(args)...);
+  };
+}
+
+/**
+ * @brief 一度だけ設定され、複数のスレッドが待機できる Result
+ * @tparam T 成功値の型
+ * @tparam E 失敗値の型
+ *
+ * 非同期処理の完了通知に使用します。設定後は変更されないため、
+ * 待機側は参照で結果を受け取ります。設定済みかの確認はアトミック変数の
+ * 読み込みのみで、待機が必要な場合のみミューテックスを取得します。
+ */
+template <typename T, typename E>
+class OnceResult final {
+ private:
+  std::atomic<bool> m_ready{false};
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::optional<Result<T, E>> m_result;
+
+ public:
+  OnceResult() = default;
+  OnceResult(const OnceResult&) = delete;
+  OnceResult& operator=(const OnceResult&) = delete;
+
+  /**
+   * @brief 結果を設定し、待機中のスレッドを起こす
+   * @param result 設定する結果
+   * @return bool 設定した場合true（設定済みの場合はfalse）
+   */
+  bool set(Result<T, E> result) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_result) {
+        return false;
+      }
+      m_result.emplace(std::move(result));
+      m_ready.store(true, std::memory_order_release);
+    }
+    m_condition.notify_all();
+    return true;
+  }
+
+  /**
+   * @brief 待機せずに結果を取得
+   * @return const Result<T, E>* 設定済みの場合は結果、未設定の場合nullptr
+   */
+  const Result<T, E>* try_get() const {
+    return m_ready.load(std::memory_order_acquire) ? &*m_result : nullptr;
+  }
+
+  /**
+   * @brief 結果が設定されるまで待機
+   * @return const Result<T, E>& 設定された結果
+   */
+  const Result<T, E>& wait() {
+    if (!m_ready.load(std::memory_order_acquire)) {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this] { return m_result.has_value(); });
+    }
+    return *m_result;
+  }
+
+  /**
+   * @brief 結果が設定されるか期限を過ぎるまで待機
+   * @param deadline 期限
+   * @return Result<const Result<T, E>&, Timeout> 期限を過ぎた場合は Timeout
+   */
+  Result<const Result<T, E>&, Timeout> wait(Deadline deadline) {
+    if (deadline.is_never()) {
+      return make_ok_ref(wait());
+    }
+    if (!m_ready.load(std::memory_order_acquire)) {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (!m_condition.wait_until(lock, deadline.time(),
+                                  [this] { return m_result.has_value(); })) {
+        return make_err(Timeout{});
+      }
+    }
+    return make_ok_ref(std::as_const(*m_result));
+  }
+};
+
+}  // namespace t9_result
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace t9_result {
+
+/**
+ * @brief 列挙型の値の範囲を定義するトレイト
+ * @tparam E 列挙型
+ *
+ * ErrorMap で変換元として使用する列挙型はこのテンプレートを特殊化し、
+ * 最小値と最大値を定義します。
+ * - static constexpr E first
+ * - static constexpr E last
+ *
+ * first から last までのすべての整数値が列挙子であることを想定します。
+ */
+template <typename E>
+struct EnumRange;
+
+/**
+ * @brief ErrorMap の対応1つ分
+ * @tparam From 変換元の列挙子
+ * @tparam To 変換先の列挙子
+ */
+template <auto From, auto To>
+struct ErrorPair {
+  static constexpr auto from = From;
+  static constexpr auto to = To;
+};
+
+namespace detail {
+
+template <typename From, typename To, typename... Pairs>
+struct ErrorMapTable {
+  using Underlying = std::underlying_type_t<From>;
+
+  static constexpr Underlying kFirst =
+      static_cast<Underlying>(EnumRange<From>::first);
+  static constexpr Underlying kLast =
+      static_cast<Underlying>(EnumRange<From>::last);
+  static constexpr std::size_t kSize =
+      kFirst <= kLast ? static_cast<std::size_t>(kLast - kFirst) + 1 : 0;
+
+  // 変換元の各値がちょうど1回ずつ現れるか
+  static constexpr bool is_complete() {
+    if (kSize == 0 || sizeof...(Pairs) != kSize) {
+      return false;
+    }
+    Underlying froms[sizeof...(Pairs) + 1] = {
+        static_cast<Underlying>(Pairs::from)...};
+    std::size_t counts[kSize + 1] = {};
+    for (std::size_t i = 0; i < sizeof...(Pairs); ++i) {
+      if (froms[i] < kFirst || froms[i] > kLast) {
+        return false;
+      }
+      ++counts[static_cast<std::size_t>(froms[i] - kFirst)];
+    }
+    for (std::size_t i = 0; i < kSize; ++i) {
+      if (counts[i] != 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  struct Table {
+    To m_values[kSize + 1];
+  };
+
+  static constexpr Table build() {
+    Table table{};
+    ((table.m_values[static_cast<std::size_t>(
+          static_cast<Underlying>(Pairs::from) - kFirst)] = Pairs::to),
+     ...);
+    return table;
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief 列挙型の失敗値を別の列挙型に変換する表
+ * @tparam From 変換元の列挙型（EnumRange を特殊化していること）
+ * @tparam To 変換先の型
+ * @tparam Pairs ErrorPair<変換元, 変換先> の並び
+ *
+ * 対応表はコンパイル時に配列として構築し、変換元のすべての値が
+ * ちょうど1回ずつ現れることを static_assert で検査します。
+ * 変換は配列の添字アクセス1回で行われ、Result::map_err() に
+ * そのまま渡せます。
+ *
+ * @code
+ * using IoToApp = ErrorMap<IoError, AppError,
+ *                          ErrorPair<IoError::NotFound, AppError::Missing>,
+ *                          ErrorPair<IoError::Denied, AppError::Forbidden>>;
+ * auto r = read_file(path).map_err(IoToApp{});
+ * @endcode
+ */
+template <typename From, typename To, typename... Pairs>
+class ErrorMap final {
+  static_assert(std::is_enum_v<From>, "From must be an enum");
+  static_assert(((std::is_same_v<std::decay_t<decltype(Pairs::from)>,
+                                 From> &&
+                  std::is_same_v<std::decay_t<decltype(Pairs::to)>, To>) &&
+                 ...),
+                "each pair must map From to To");
+
+ private:
+  using Detail = detail::ErrorMapTable<From, To, Pairs...>;
+  static_assert(Detail::is_complete(),
+                "ErrorMap must map every value of From exactly once");
+
+  static constexpr typename Detail::Table kTable = Detail::build();
+
+ public:
+  /**
+   * @brief 失敗値を変換
+   * @param from 変換元の値
+   * @return To 変換後の値
+   * @note EnumRange の範囲外の値はアサーション違反
+   */
+  constexpr To operator()(From from) const {
+    auto index = static_cast<std::size_t>(
+        static_cast<typename Detail::Underlying>(from) - Detail::kFirst);
+    assert(index < Detail::kSize);
+    return kTable.m_values[index];
+  }
+};
+
+}  // namespace t9_result
@@ -0,0 +1,542 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define T9_RESULT_FLAT_MAP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "alloc.h"
+#include "result.h"
+
+namespace t9_result {
+
+/**
+ * @brief キーが見つからなかったことを表すエラー
+ */
+struct NotFound {};
+
+/**
+ * @brief 挿入のエラー
+ */
+enum class InsertError {
+  KeyExists,    ///< 同じキーがすでに存在する
+  OutOfMemory,  ///< 拡張のためのメモリが不足している
+};
+
+namespace detail {
+
+// 制御バイト。0〜127 は使用中のスロットでハッシュ値の下位7ビットを保持する
+constexpr std::int8_t kCtrlEmpty = -128;
+constexpr std::int8_t kCtrlDeleted = -2;
+constexpr std::size_t kGroupWidth = 16;
+
+inline std::uint32_t count_trailing_zeros(std::uint32_t mask) {
+#if defined(_MSC_VER)
+  unsigned long index = 0;
+  _BitScanForward(&index, mask);
+  return index;
+#else
+  return static_cast<std::uint32_t>(__builtin_ctz(mask));
+#endif
+}
+
+/**
+ * @brief 制御バイト16個分をまとめて検査するグループ
+ *
+ * SSE2 が利用できる場合は1命令で16スロットを比較し、
+ * それ以外の環境ではスカラーで同じビットマスクを生成します。
+ */
+class Group final {
+ private:
+#if defined(T9_RESULT_FLAT_MAP_SSE2)
+  __m128i m_ctrl;
+#else
+  const std::int8_t* m_ctrl;
+#endif
+
+ public:
+  explicit Group(const std::int8_t* ctrl)
+#if defined(T9_RESULT_FLAT_MAP_SSE2)
+      : m_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {
+  }
+#else
+      : m_ctrl(ctrl) {
+  }
+#endif
+
+  // h2 と一致するスロットのビットマスク
+  std::uint32_t match(std::int8_t h2) const {
+#if defined(T9_RESULT_FLAT_MAP_SSE2)
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl)));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kGroupWidth; ++i) {
+      mask |= std::uint32_t{m_ctrl[i] == h2} << i;
+    }
+    return mask;
+#endif
+  }
+
+  // 空きスロットのビットマスク
+  std::uint32_t match_empty() const {
+    return match(kCtrlEmpty);
+  }
+
+  // 空き・削除済みスロットのビットマスク
+  std::uint32_t match_empty_or_deleted() const {
+#if defined(T9_RESULT_FLAT_MAP_SSE2)
+    // 使用中のスロットは符号ビットが立っていない
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(m_ctrl));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kGroupWidth; ++i) {
+      mask |= std::uint32_t{m_ctrl[i] < 0} << i;
+    }
+    return mask;
+#endif
+  }
+};
+
+// std::hash の恒等写像的な実装でも上位・下位ビットが分散するよう混ぜる
+inline std::uint64_t mix_hash(std::uint64_t h) {
+  h ^= h >> 32;
+  h *= 0x9E3779B97F4A7C15ull;
+  h ^= h >> 29;
+  return h;
+}
+
+}  // namespace detail
+
+/**
+ * @brief オープンアドレス法のハッシュマップ
+ * @tparam K キーの型
+ * @tparam V 値の型
+ * @tparam Hash ハッシュ関数
+ * @tparam KeyEqual キーの比較関数
+ *
+ * 制御バイトとスロットを連続した配列に持ち、16スロット単位のグループを
+ * SIMD でまとめて検査しながらプローブします（SwissTable 方式）。
+ * 検索は Result<V&, NotFound>、挿入は Result<V&, InsertError> を返し、
+ * メモリ不足も例外ではなくエラーとして返します。
+ *
+ * 挿入・削除・拡張によって既存の要素への参照は無効になることがあります。
+ */
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class FlatMap final {
+ public:
+  /**
+   * @brief キーと値の組
+   */
+  struct Entry {
+    K m_key;
+    V m_value;
+  };
+
+ private:
+  std::int8_t* m_ctrl = nullptr;
+  Entry* m_slots = nullptr;
+  std::size_t m_capacity = 0;  // 0 または kGroupWidth の倍数（2のべき乗）
+  std::size_t m_size = 0;
+  std::size_t m_growth_left = 0;
+  Hash m_hash;
+  KeyEqual m_equal;
+
+  static constexpr std::size_t max_load(std::size_t capacity) {
+    return capacity - capacity / 8;
+  }
+
+  std::uint64_t hash_of(const K& key) const {
+    return detail::mix_hash(static_cast<std::uint64_t>(m_hash(key)));
+  }
+
+  static std::int8_t h2(std::uint64_t hash) {
+    return static_cast<std::int8_t>(hash & 0x7F);
+  }
+
+  // グループ単位の二次プローブ列
+  class Probe final {
+   private:
+    std::size_t m_mask;
+    std::size_t m_group;
+    std::size_t m_stride = 0;
+
+   public:
+    Probe(std::uint64_t hash, std::size_t capacity)
+        : m_mask(capacity / detail::kGroupWidth - 1),
+          m_group(static_cast<std::size_t>(hash >> 7) & m_mask) {}
+
+    std::size_t offset() const {
+      return m_group * detail::kGroupWidth;
+    }
+
+    void next() {
+      ++m_stride;
+      m_group = (m_group + m_stride) & m_mask;
+    }
+  };
+
+  Entry* find_slot(const K& key, std::uint64_t hash) const {
+    if (m_capacity == 0) {
+      return nullptr;
+    }
+    for (Probe probe(hash, m_capacity);; probe.next()) {
+      detail::Group group(m_ctrl + probe.offset());
+      for (std::uint32_t mask = group.match(h2(hash)); mask != 0;
+           mask &= mask - 1) {
+        std::size_t index =
+            probe.offset() + detail::count_trailing_zeros(mask);
+        if (m_equal(m_slots[index].m_key, key)) {
+          return m_slots + index;
+        }
+      }
+      if (group.match_empty() != 0) {
+        return nullptr;
+      }
+    }
+  }
+
+  std::size_t find_insert_index(std::uint64_t hash) const {
+    for (Probe probe(hash, m_capacity);; probe.next()) {
+      std::uint32_t mask =
+          detail::Group(m_ctrl + probe.offset()).match_empty_or_deleted();
+      if (mask != 0) {
+        return probe.offset() + detail::count_trailing_zeros(mask);
+      }
+    }
+  }
+
+  void release() {
+    if (m_capacity == 0) {
+      return;
+    }
+    if constexpr (!std::is_trivially_destructible_v<Entry>) {
+      for (std::size_t i = 0; i < m_capacity; ++i) {
+        if (m_ctrl[i] >= 0) {
+          m_slots[i].~Entry();
+        }
+      }
+    }
+    deallocate(m_ctrl);
+    deallocate(m_slots);
+    m_ctrl = nullptr;
+    m_slots = nullptr;
+    m_capacity = 0;
+    m_size = 0;
+    m_growth_left = 0;
+  }
+
+  Result<void, AllocError> rehash(std::size_t capacity) {
+    auto ctrl = try_allocate<std::int8_t>(capacity);
+    if (ctrl.is_err()) {
+      return make_err(ctrl.unwrap_err());
+    }
+    auto slots = try_allocate<Entry>(capacity);
+    if (slots.is_err()) {
+      deallocate(ctrl.unwrap());
+      return make_err(slots.unwrap_err());
+    }
+    FlatMap next(m_hash, m_equal);
+    next.m_ctrl = ctrl.unwrap();
+    next.m_slots = slots.unwrap();
+    next.m_capacity = capacity;
+    std::memset(next.m_ctrl, static_cast<unsigned char>(detail::kCtrlEmpty),
+                capacity);
+    for (std::size_t i = 0; i < m_capacity; ++i) {
+      if (m_ctrl[i] >= 0) {
+        std::uint64_t hash = hash_of(m_slots[i].m_key);
+        std::size_t index = next.find_insert_index(hash);
+        next.m_ctrl[index] = h2(hash);
+        new (next.m_slots + index) Entry(std::move(m_slots[i]));
+      }
+    }
+    next.m_size = m_size;
+    next.m_growth_left = max_load(capacity) - m_size;
+    swap(next);
+    return make_ok();
+  }
+
+  // 空きスロットを1つ確保できる状態にする
+  Result<void, AllocError> prepare_insert() {
+    if (m_growth_left > 0) {
+      return make_ok();
+    }
+    // 削除済みスロットが多い場合は同じ容量で詰め直す
+    if (m_capacity != 0 && m_size <= max_load(m_capacity) / 2) {
+      return rehash(m_capacity);
+    }
+    return rehash(m_capacity == 0 ? detail::kGroupWidth : m_capacity * 2);
+  }
+
+  template <typename Key, typename... Args>
+  Entry* emplace_new(std::uint64_t hash, Key&& key, Args&&... args) {
+    std::size_t index = find_insert_index(hash);
+    if (m_ctrl[index] == detail::kCtrlEmpty) {
+      --m_growth_left;
+    }
+    m_ctrl[index] = h2(hash);
+    ++m_size;
+    return new (m_slots + index)
+        Entry{K(std::forward<Key>(key)), V(std::forward<Args>(args)...)};
+  }
+
+ public:
+  explicit FlatMap(const Hash& hash = Hash(),
+                   const KeyEqual& equal = KeyEqual())
+      : m_hash(hash), m_equal(equal) {}
+
+  FlatMap(const FlatMap&) = delete;
+  FlatMap& operator=(const FlatMap&) = delete;
+
+  FlatMap(FlatMap&& other)
+      : m_ctrl(std::exchange(other.m_ctrl, nullptr)),
+        m_slots(std::exchange(other.m_slots, nullptr)),
+        m_capacity(std::exchange(other.m_capacity, 0)),
+        m_size(std::exchange(other.m_size, 0)),
+        m_growth_left(std::exchange(other.m_growth_left, 0)),
+        m_hash(other.m_hash),
+        m_equal(other.m_equal) {}
+
+  FlatMap& operator=(FlatMap&& other) {
+    FlatMap(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  ~FlatMap() {
+    release();
+  }
+
+  void swap(FlatMap& other) {
+    using std::swap;
+    swap(m_ctrl, other.m_ctrl);
+    swap(m_slots, other.m_slots);
+    swap(m_capacity, other.m_capacity);
+    swap(m_size, other.m_size);
+    swap(m_growth_left, other.m_growth_left);
+    swap(m_hash, other.m_hash);
+    swap(m_equal, other.m_equal);
+  }
+
+  /**
+   * @brief 少なくとも指定数の要素を再配置なしで格納できるよう領域を確保
+   * @param count 要素数
+   * @return Result<void, AllocError> 確保に失敗した場合はエラー
+   */
+  Result<void, AllocError> reserve(std::size_t count) {
+    std::size_t capacity = detail::kGroupWidth;
+    while (max_load(capacity) < count) {
+      if (capacity > (std::numeric_limits<std::size_t>::max() >> 1)) {
+        return make_err(AllocError::SizeOverflow);
+      }
+      capacity *= 2;
+    }
+    if (capacity <= m_capacity) {
+      return make_ok();
+    }
+    return rehash(capacity);
+  }
+
+  /**
+   * @brief キーに対応する値を取得
+   * @param key 検索するキー
+   * @return Result<V&, NotFound> 値への参照
+   */
+  Result<V&, NotFound> try_get(const K& key) {
+    Entry* entry = find_slot(key, hash_of(key));
+    if (!entry) {
+      return make_err(NotFound{});
+    }
+    return make_ok_ref(entry->m_value);
+  }
+
+  /**
+   * @brief キーに対応する値を取得
+   * @param key 検索するキー
+   * @return Result<const V&, NotFound> 値への const 参照
+   */
+  Result<const V&, NotFound> try_get(const K& key) const {
+    const Entry* entry = find_slot(key, hash_of(key));
+    if (!entry) {
+      return make_err(NotFound{});
+    }
+    return make_ok_ref(entry->m_value);
+  }
+
+  /**
+   * @brief キーが存在するか確認
+   * @param key 検索するキー
+   * @return bool 存在する場合true
+   */
+  bool contains(const K& key) const {
+    return find_slot(key, hash_of(key)) != nullptr;
+  }
+
+  /**
+   * @brief キーが存在しない場合に値を直接構築して挿入
+   * @tparam Args 値のコンストラクタ引数の型
+   * @param key 挿入するキー
+   * @param args 値のコンストラクタに渡す引数
+   * @return Result<V&, InsertError> 挿入した値への参照
+   *
+   * キーがすでに存在する場合は InsertError::KeyExists を返し、
+   * 既存の値は変更しません。
+   * 引数はこのマップの要素を参照していても構いません。
+   */
+  template <typename Key, typename... Args>
+  Result<V&, InsertError> try_emplace(Key&& key, Args&&... args) {
+    if constexpr (!std::is_same_v<std::decay_t<Key>, K>) {
+      // ハッシュ・プローブ・格納で変換を繰り返さないよう、先に一度だけ変換する
+      return try_emplace(K(std::forward<Key>(key)),
+                         std::forward<Args>(args)...);
+    } else {
+      std::uint64_t hash = hash_of(key);
+      if (find_slot(key, hash)) {
+        return make_err(InsertError::KeyExists);
+      }
+      if (m_growth_left == 0) {
+        // 拡張で要素が移動しても引数が無効にならないよう、先に構築しておく
+        K stored_key(std::forward<Key>(key));
+        V value(std::forward<Args>(args)...);
+        if (prepare_insert().is_err()) {
+          return make_err(InsertError::OutOfMemory);
+        }
+        Entry* entry = emplace_new(hash, std::move(stored_key),
+                                   std::move(value));
+        return make_ok_ref(entry->m_value);
+      }
+      Entry* entry = emplace_new(hash, std::forward<Key>(key),
+                                 std::forward<Args>(args)...);
+      return make_ok_ref(entry->m_value);
+    }
+  }
+
+  /**
+   * @brief キーが存在しない場合に値を挿入
+   * @param key 挿入するキー
+   * @param value 挿入する値
+   * @return Result<V&, InsertError> 挿入した値への参照
+   */
+  Result<V&, InsertError> try_insert(K key, V value) {
+    return try_emplace(std::move(key), std::move(value));
+  }
+
+  /**
+   * @brief 値を挿入し、キーがすでに存在する場合は上書き
+   * @param key 挿入するキー
+   * @param value 挿入する値
+   * @return Result<V&, InsertError> 挿入または上書きした値への参照
+   */
+  Result<V&, InsertError> try_insert_or_assign(K key, V value) {
+    std::uint64_t hash = hash_of(key);
+    if (Entry* entry = find_slot(key, hash)) {
+      entry->m_value = std::move(value);
+      return make_ok_ref(entry->m_value);
+    }
+    if (prepare_insert().is_err()) {
+      return make_err(InsertError::OutOfMemory);
+    }
+    Entry* entry = emplace_new(hash, std::move(key), std::move(value));
+    return make_ok_ref(entry->m_value);
+  }
+
+  /**
+   * @brief キーに対応する要素を削除
+   * @param key 削除するキー
+   * @return bool 削除した場合true
+   */
+  bool erase(const K& key) {
+    Entry* entry = find_slot(key, hash_of(key));
+    if (!entry) {
+      return false;
+    }
+    auto index = static_cast<std::size_t>(entry - m_slots);
+    entry->~Entry();
+    --m_size;
+    // 同じグループに空きスロットがあれば、このグループを越えて
+    // プローブした要素はないため空きに戻せる
+    std::size_t group = index & ~(detail::kGroupWidth - 1);
+    if (detail::Group(m_ctrl + group).match_empty() != 0) {
+      m_ctrl[index] = detail::kCtrlEmpty;
+      ++m_growth_left;
+    } else {
+      m_ctrl[index] = detail::kCtrlDeleted;
+    }
+    return true;
+  }
+
+  /**
+   * @brief すべての要素を削除（確保した領域は保持する）
+   */
+  void clear() {
+    if constexpr (!std::is_trivially_destructible_v<Entry>) {
+      for (std::size_t i = 0; i < m_capacity; ++i) {
+        if (m_ctrl[i] >= 0) {
+          m_slots[i].~Entry();
+        }
+      }
+    }
+    if (m_capacity != 0) {
+      std::memset(m_ctrl, static_cast<unsigned char>(detail::kCtrlEmpty),
+                  m_capacity);
+    }
+    m_size = 0;
+    m_growth_left = max_load(m_capacity);
+  }
+
+  /**
+   * @brief すべての要素に関数を適用
+   * @param f const K& と V& を受け取る関数（キーは変更できない）
+   */
+  template <typename F>
+  void for_each(F&& f) {
+    for (std::size_t i = 0; i < m_capacity; ++i) {
+      if (m_ctrl[i] >= 0) {
+        f(static_cast<const K&>(m_slots[i].m_key), m_slots[i].m_value);
+      }
+    }
+  }
+
+  /**
+   * @brief すべての要素に関数を適用
+   * @param f const K& と const V& を受け取る関数
+   */
+  template <typename F>
+  void for_each(F&& f) const {
+    for (std::size_t i = 0; i < m_capacity; ++i) {
+      if (m_ctrl[i] >= 0) {
+        f(static_cast<const K&>(m_slots[i].m_key),
+          static_cast<const V&>(m_slots[i].m_value));
+      }
+    }
+  }
+
+  std::size_t size() const {
+    return m_size;
+  }
+
+  bool empty() const {
+    return m_size == 0;
+  }
+
+  std::size_t capacity() const {
+    return m_capacity;
+  }
+};
+
+}  // namespace t9_result
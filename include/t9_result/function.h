@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace t9_result {
+
+template <typename Signature>
+class FunctionRef;
+
+/**
+ * @brief 呼び出し可能オブジェクトを所有しない軽量な参照
+ * @tparam R 戻り値の型
+ * @tparam Args 引数の型
+ *
+ * ポインタ2つ分の大きさで、メモリ確保を行いません。
+ * 参照先の呼び出し可能オブジェクトは FunctionRef より長く生存している
+ * 必要があるため、関数の引数として受け取る用途に使用します。
+ * Result の map_err() や inspect_err() などにもそのまま渡せます。
+ */
+template <typename R, typename... Args>
+class FunctionRef<R(Args...)> final {
+ private:
+  union Target {
+    void* m_object;
+    void (*m_function)();
+  };
+
+  Target m_target;
+  R (*m_invoke)(Target, Args...);
+
+  template <typename F>
+  static constexpr bool is_function_pointer_v =
+      std::is_pointer_v<std::decay_t<F>> &&
+      std::is_function_v<std::remove_pointer_t<std::decay_t<F>>>;
+
+ public:
+  /**
+   * @brief 呼び出し可能オブジェクトを参照
+   * @tparam F 呼び出し可能オブジェクトの型
+   * @param f 参照する呼び出し可能オブジェクト
+   */
+  template <typename F,
+            std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, FunctionRef> &&
+                    std::is_invocable_r_v<R, F&, Args...>,
+                int> = 0>
+  FunctionRef(F&& f) {
+    if constexpr (is_function_pointer_v<F>) {
+      // 関数ポインタは一時オブジェクトになり得るため値として保持する
+      using Pointer = std::decay_t<F>;
+      m_target.m_function = reinterpret_cast<void (*)()>(Pointer(f));
+      m_invoke = [](Target target, Args... args) -> R {
+        auto function = reinterpret_cast<Pointer>(target.m_function);
+        // R が void の場合は値を返す関数も受け付け、戻り値を捨てる
+        if constexpr (std::is_void_v<R>) {
+          function(std::forward<Args>(args)...);
+        } else {
+          return function(std::forward<Args>(args)...);
+        }
+      };
+    } else {
+      using Object = std::remove_reference_t<F>;
+      m_target.m_object =
+          const_cast<void*>(static_cast<const void*>(std::addressof(f)));
+      m_invoke = [](Target target, Args... args) -> R {
+        auto& object = *static_cast<Object*>(target.m_object);
+        if constexpr (std::is_void_v<R>) {
+          object(std::forward<Args>(args)...);
+        } else {
+          return object(std::forward<Args>(args)...);
+        }
+      };
+    }
+  }
+
+  /**
+   * @brief 参照先を呼び出す
+   * @param args 引数
+   * @return R 呼び出し結果
+   */
+  R operator()(Args... args) const {
+    return m_invoke(m_target, std::forward<Args>(args)...);
+  }
+};
+
+template <typename Signature, std::size_t Capacity = 4 * sizeof(void*)>
+class UniqueFunction;
+
+/**
+ * @brief 呼び出し可能オブジェクトを内部バッファに所有する関数ラッパー
+ * @tparam R 戻り値の型
+ * @tparam Args 引数の型
+ * @tparam Capacity 内部バッファのバイト数
+ *
+ * std::function と異なりムーブのみ可能で、ヒープを使用しません。
+ * Capacity に収まらない呼び出し可能オブジェクトはコンパイルエラーになります。
+ * 既定の容量はポインタ4つ分で、参照を数個キャプチャするラムダが収まります。
+ * ロガーやエラーの通知先など、長く保持するコールバックに使用します。
+ */
+template <typename R, typename... Args, std::size_t Capacity>
+class UniqueFunction<R(Args...), Capacity> final {
+ private:
+  struct Operations {
+    R (*m_invoke)(void*, Args...);
+    void (*m_move)(void*, void*);  // 構築先、ムーブ元
+    void (*m_destroy)(void*);
+  };
+
+  template <typename F>
+  static constexpr Operations kOperations = {
+      [](void* object, Args... args) -> R {
+        // R が void の場合は値を返す関数も受け付け、戻り値を捨てる
+        if constexpr (std::is_void_v<R>) {
+          (*static_cast<F*>(object))(std::forward<Args>(args)...);
+        } else {
+          return (*static_cast<F*>(object))(std::forward<Args>(args)...);
+        }
+      },
+      [](void* to, void* from) {
+        new (to) F(std::move(*static_cast<F*>(from)));
+        static_cast<F*>(from)->~F();
+      },
+      [](void* object) { static_cast<F*>(object)->~F(); },
+  };
+
+  alignas(std::max_align_t) std::byte m_storage[Capacity];
+  const Operations* m_operations = nullptr;
+
+  void reset() {
+    if (m_operations) {
+      m_operations->m_destroy(m_storage);
+      m_operations = nullptr;
+    }
+  }
+
+ public:
+  UniqueFunction() = default;
+
+  /**
+   * @brief 呼び出し可能オブジェクトを内部バッファに格納
+   * @tparam F 呼び出し可能オブジェクトの型
+   * @param f 格納する呼び出し可能オブジェクト
+   */
+  template <typename F,
+            std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, UniqueFunction> &&
+                    std::is_invocable_r_v<R, std::decay_t<F>&, Args...>,
+                int> = 0>
+  UniqueFunction(F&& f) {
+    using Stored = std::decay_t<F>;
+    static_assert(sizeof(Stored) <= Capacity,
+                  "callable does not fit in UniqueFunction buffer");
+    static_assert(alignof(Stored) <= alignof(std::max_align_t),
+                  "callable is over-aligned");
+    new (m_storage) Stored(std::forward<F>(f));
+    m_operations = &kOperations<Stored>;
+  }
+
+  UniqueFunction(const UniqueFunction&) = delete;
+  UniqueFunction& operator=(const UniqueFunction&) = delete;
+
+  UniqueFunction(UniqueFunction&& other)
+      : m_operations(std::exchange(other.m_operations, nullptr)) {
+    if (m_operations) {
+      m_operations->m_move(m_storage, other.m_storage);
+    }
+  }
+
+  UniqueFunction& operator=(UniqueFunction&& other) {
+    if (this != &other) {
+      reset();
+      m_operations = std::exchange(other.m_operations, nullptr);
+      if (m_operations) {
+        m_operations->m_move(m_storage, other.m_storage);
+      }
+    }
+    return *this;
+  }
+
+  ~UniqueFunction() {
+    reset();
+  }
+
+  /**
+   * @brief 呼び出し可能オブジェクトを保持しているか確認
+   * @return bool 保持している場合true
+   */
+  explicit operator bool() const {
+    return m_operations != nullptr;
+  }
+
+  /**
+   * @brief 保持している呼び出し可能オブジェクトを呼び出す
+   * @param args 引数
+   * @return R 呼び出し結果
+   * @note 空の場合はアサーション違反
+   */
+  R operator()(Args... args) {
+    assert(m_operations);
+    return m_operations->m_invoke(m_storage, std::forward<Args>(args)...);
+  }
+};
+
+}  // namespace t9_result
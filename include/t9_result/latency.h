@@ -0,0 +1,475 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "alloc.h"
+#include "result.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace t9_result {
+
+namespace detail {
+
+template <typename E, typename = void>
+struct HasCodeMember : std::false_type {};
+
+template <typename E>
+struct HasCodeMember<E, std::void_t<decltype(std::declval<const E&>().code())>>
+    : std::is_integral<decltype(std::declval<const E&>().code())> {};
+
+// 失敗値から集計用のコードを取り出せるか（列挙型、整数型、code() を持つ型）
+template <typename E>
+constexpr bool has_error_code_v =
+    std::is_enum_v<E> ||
+    (std::is_integral_v<E> && !std::is_same_v<E, bool>) ||
+    HasCodeMember<E>::value;
+
+template <typename E>
+std::int64_t error_code_of(const E& error) {
+  if constexpr (HasCodeMember<E>::value) {
+    return static_cast<std::int64_t>(error.code());
+  } else {
+    return static_cast<std::int64_t>(error);
+  }
+}
+
+// 最上位の1のビット位置（value != 0）
+inline std::uint32_t highest_bit(std::uint64_t value) {
+#if defined(_MSC_VER)
+  unsigned long index = 0;
+  _BitScanReverse64(&index, value);
+  return index;
+#else
+  return 63 - static_cast<std::uint32_t>(__builtin_clzll(value));
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * @brief 対数線形のバケットで集計したレイテンシの分布
+ *
+ * 2のべき乗ごとの区間を 2^kSubBucketBits 個の等幅バケットに分割します
+ * （相対誤差は約 6%）。値はナノ秒で、2^kMaxExponent ナノ秒
+ * （約18分）以上は最後の区間にまとめます。
+ */
+class LatencyHistogram final {
+ public:
+  static constexpr std::uint32_t kSubBucketBits = 4;
+  static constexpr std::uint32_t kMaxExponent = 40;
+  static constexpr std::size_t kBucketCount =
+      std::size_t{kMaxExponent - kSubBucketBits + 2} << kSubBucketBits;
+
+ private:
+  std::uint64_t m_counts[kBucketCount] = {};
+  std::uint64_t m_count = 0;
+  std::uint64_t m_sum = 0;
+  std::uint64_t m_max = 0;
+
+ public:
+  /**
+   * @brief 値に対応するバケットの番号を取得
+   * @param value 値（ナノ秒）
+   * @return std::size_t バケットの番号
+   */
+  static std::size_t bucket_of(std::uint64_t value) {
+    constexpr std::uint64_t kSubBuckets = std::uint64_t{1} << kSubBucketBits;
+    if (value < kSubBuckets) {
+      return static_cast<std::size_t>(value);
+    }
+    std::uint32_t exponent = detail::highest_bit(value);
+    if (exponent > kMaxExponent) {
+      return kBucketCount - 1;
+    }
+    std::uint32_t shift = exponent - kSubBucketBits;
+    return static_cast<std::size_t>(
+        (std::uint64_t{shift + 1} << kSubBucketBits) |
+        ((value >> shift) & (kSubBuckets - 1)));
+  }
+
+  /**
+   * @brief バケットに含まれる最大の値を取得
+   * @param bucket バケットの番号
+   * @return std::uint64_t 値（ナノ秒）
+   */
+  static std::uint64_t upper_bound_of(std::size_t bucket) {
+    constexpr std::uint64_t kSubBuckets = std::uint64_t{1} << kSubBucketBits;
+    if (bucket < kSubBuckets) {
+      return bucket;
+    }
+    std::uint64_t shift = (bucket >> kSubBucketBits) - 1;
+    std::uint64_t sub = bucket & (kSubBuckets - 1);
+    return ((kSubBuckets + sub + 1) << shift) - 1;
+  }
+
+  /**
+   * @brief 値を1件記録
+   * @param value 値（ナノ秒）
+   */
+  void record(std::uint64_t value) {
+    ++m_counts[bucket_of(value)];
+    ++m_count;
+    m_sum += value;
+    m_max = std::max(m_max, value);
+  }
+
+  /**
+   * @brief バケットの件数を加算
+   * @param bucket バケットの番号
+   * @param count 件数
+   */
+  void add_bucket(std::size_t bucket, std::uint64_t count) {
+    m_counts[bucket] += count;
+    m_count += count;
+  }
+
+  /**
+   * @brief 別の分布を合算
+   * @param other 合算する分布
+   */
+  void merge(const LatencyHistogram& other) {
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+      m_counts[i] += other.m_counts[i];
+    }
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_max = std::max(m_max, other.m_max);
+  }
+
+  /**
+   * @brief 分位点を取得
+   * @param quantile 分位（0.0〜1.0）
+   * @return std::uint64_t 分位点を含むバケットの上限値（ナノ秒）
+   */
+  std::uint64_t percentile(double quantile) const {
+    if (m_count == 0) {
+      return 0;
+    }
+    auto rank = static_cast<std::uint64_t>(quantile * m_count);
+    rank = std::min(std::max<std::uint64_t>(rank, 1), m_count);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+      seen += m_counts[i];
+      if (seen >= rank) {
+        return std::min(upper_bound_of(i), m_max);
+      }
+    }
+    return m_max;
+  }
+
+  std::uint64_t bucket_count(std::size_t bucket) const {
+    return m_counts[bucket];
+  }
+
+  std::uint64_t count() const {
+    return m_count;
+  }
+
+  std::uint64_t sum() const {
+    return m_sum;
+  }
+
+  std::uint64_t max() const {
+    return m_max;
+  }
+
+  friend class LatencySite;
+};
+
+/**
+ * @brief 呼び出し箇所ごとのレイテンシを成功・失敗に分けて集計する
+ *
+ * スレッドごとに専用のバケット配列（シャード）を持ち、記録は所有する
+ * スレッドのみがロックなしで書き込みます。snapshot() は全スレッドの
+ * シャードをロックなしで読み出して合算します。
+ * シャードはスレッドの終了後も保持され、LatencySite の破棄時に解放されます。
+ *
+ * 失敗は record_error_code() でコードごとの件数も集計できます。
+ * コードは 0〜kErrorCodeCount-1 を個別に、それ以外はまとめて数えます。
+ *
+ * 生成した LatencySite は LatencyRegistry に登録され、エクスポートなどで
+ * 列挙できます。通常は関数内の static 変数として定義します。
+ */
+class LatencySite final {
+ public:
+  /// 個別に集計する失敗値のコードの数
+  static constexpr std::size_t kErrorCodeCount = 64;
+
+ private:
+  // 1スレッド分の集計
+  struct Shard {
+    struct Counters {
+      std::atomic<std::uint64_t> m_buckets[LatencyHistogram::kBucketCount];
+      std::atomic<std::uint64_t> m_sum;
+      std::atomic<std::uint64_t> m_max;
+    };
+    Counters m_ok;
+    Counters m_err;
+    // 末尾は範囲外のコード
+    std::atomic<std::uint64_t> m_error_codes[kErrorCodeCount + 1];
+    Shard* m_next = nullptr;
+
+    Shard() {
+      for (Counters* counters : {&m_ok, &m_err}) {
+        for (auto& bucket : counters->m_buckets) {
+          bucket.store(0, std::memory_order_relaxed);
+        }
+        counters->m_sum.store(0, std::memory_order_relaxed);
+        counters->m_max.store(0, std::memory_order_relaxed);
+      }
+      for (auto& code : m_error_codes) {
+        code.store(0, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  // 所有スレッドのみが書き込むため、読み出しと加算を分けてよい
+  static void bump(std::atomic<std::uint64_t>& counter, std::uint64_t n) {
+    counter.store(counter.load(std::memory_order_relaxed) + n,
+                  std::memory_order_relaxed);
+  }
+
+  const char* m_name;
+  std::size_t m_id;
+  std::atomic<Shard*> m_shards{nullptr};
+
+  static std::size_t next_id() {
+    static std::atomic<std::size_t> id{0};
+    return id.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  Shard* local_shard() {
+    thread_local std::vector<Shard*> shards;
+    if (m_id < shards.size() && shards[m_id]) {
+      return shards[m_id];
+    }
+    auto created = try_new<Shard>();
+    if (created.is_err()) {
+      return nullptr;
+    }
+    Shard* shard = created.unwrap();
+    shard->m_next = m_shards.load(std::memory_order_relaxed);
+    while (!m_shards.compare_exchange_weak(shard->m_next, shard,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+    }
+    if (m_id >= shards.size()) {
+      shards.resize(m_id + 1, nullptr);
+    }
+    shards[m_id] = shard;
+    return shard;
+  }
+
+  static void collect(const Shard::Counters& counters,
+                      LatencyHistogram& histogram) {
+    for (std::size_t i = 0; i < LatencyHistogram::kBucketCount; ++i) {
+      std::uint64_t n = counters.m_buckets[i].load(std::memory_order_relaxed);
+      if (n != 0) {
+        histogram.add_bucket(i, n);
+      }
+    }
+    histogram.m_sum += counters.m_sum.load(std::memory_order_relaxed);
+    histogram.m_max = std::max(
+        histogram.m_max, counters.m_max.load(std::memory_order_relaxed));
+  }
+
+ public:
+  /**
+   * @brief 呼び出し箇所を生成して登録
+   * @param name 呼び出し箇所の名前（静的な文字列）
+   */
+  explicit LatencySite(const char* name);
+
+  LatencySite(const LatencySite&) = delete;
+  LatencySite& operator=(const LatencySite&) = delete;
+
+  ~LatencySite();
+
+  const char* name() const {
+    return m_name;
+  }
+
+  /**
+   * @brief レイテンシを1件記録
+   * @param ok 成功した場合true
+   * @param nanoseconds レイテンシ（ナノ秒）
+   *
+   * シャードの確保に失敗した場合は記録しません。
+   */
+  void record(bool ok, std::uint64_t nanoseconds) {
+    Shard* shard = local_shard();
+    if (!shard) {
+      return;
+    }
+    Shard::Counters& counters = ok ? shard->m_ok : shard->m_err;
+    bump(counters.m_buckets[LatencyHistogram::bucket_of(nanoseconds)], 1);
+    bump(counters.m_sum, nanoseconds);
+    if (nanoseconds > counters.m_max.load(std::memory_order_relaxed)) {
+      counters.m_max.store(nanoseconds, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief 失敗値のコードを1件記録
+   * @param code 失敗値のコード
+   *
+   * シャードの確保に失敗した場合は記録しません。
+   */
+  void record_error_code(std::int64_t code) {
+    Shard* shard = local_shard();
+    if (!shard) {
+      return;
+    }
+    std::size_t index = kErrorCodeCount;
+    if (code >= 0 && static_cast<std::uint64_t>(code) < kErrorCodeCount) {
+      index = static_cast<std::size_t>(code);
+    }
+    bump(shard->m_error_codes[index], 1);
+  }
+
+  /**
+   * @brief 成功・失敗それぞれの分布と失敗値のコードごとの件数
+   */
+  struct Snapshot {
+    LatencyHistogram m_ok;
+    LatencyHistogram m_err;
+    /// コードごとの件数（末尾は範囲外のコードの合計）
+    std::uint64_t m_error_codes[kErrorCodeCount + 1] = {};
+  };
+
+  /**
+   * @brief 全スレッドの集計を合算した分布を取得
+   * @return Snapshot 成功・失敗それぞれの分布
+   *
+   * 記録中のスレッドとは同期しないため、同時に記録された値は
+   * 含まれない場合があります。
+   */
+  Snapshot snapshot() const {
+    Snapshot result;
+    for (const Shard* shard = m_shards.load(std::memory_order_acquire); shard;
+         shard = shard->m_next) {
+      collect(shard->m_ok, result.m_ok);
+      collect(shard->m_err, result.m_err);
+      for (std::size_t i = 0; i <= kErrorCodeCount; ++i) {
+        result.m_error_codes[i] +=
+            shard->m_error_codes[i].load(std::memory_order_relaxed);
+      }
+    }
+    return result;
+  }
+};
+
+/**
+ * @brief 生成されたすべての LatencySite の一覧
+ *
+ * 登録と削除は LatencySite の生成・破棄時のみ行われるため、
+ * ミューテックスで保護します。
+ */
+class LatencyRegistry final {
+ private:
+  std::mutex m_mutex;
+  std::vector<LatencySite*> m_sites;
+
+  LatencyRegistry() = default;
+
+  friend class LatencySite;
+
+  void add(LatencySite* site) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sites.push_back(site);
+  }
+
+  void remove(LatencySite* site) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sites.erase(std::remove(m_sites.begin(), m_sites.end(), site),
+                  m_sites.end());
+  }
+
+ public:
+  /**
+   * @brief 共有のインスタンスを取得
+   * @return LatencyRegistry& インスタンス
+   */
+  static LatencyRegistry& instance() {
+    static LatencyRegistry registry;
+    return registry;
+  }
+
+  /**
+   * @brief 登録されているすべての呼び出し箇所に関数を適用
+   * @param f LatencySite& を受け取る関数
+   */
+  template <typename F>
+  void for_each(F&& f) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (LatencySite* site : m_sites) {
+      f(*site);
+    }
+  }
+};
+
+inline LatencySite::LatencySite(const char* name)
+    : m_name(name), m_id(next_id()) {
+  LatencyRegistry::instance().add(this);
+}
+
+inline LatencySite::~LatencySite() {
+  LatencyRegistry::instance().remove(this);
+  Shard* shard = m_shards.load(std::memory_order_acquire);
+  while (shard) {
+    delete std::exchange(shard, shard->m_next);
+  }
+}
+
+namespace detail {
+
+inline std::uint64_t latency_now() {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+}  // namespace detail
+
+/**
+ * @brief Result を返す関数を呼び出し、レイテンシを記録
+ * @tparam F Result を返す関数の型
+ * @param site 記録先の呼び出し箇所
+ * @param f 呼び出す関数
+ * @return decltype(f()) f の戻り値
+ *
+ * 失敗値が列挙型、整数型、または整数を返す code() を持つ型の場合は、
+ * そのコードも record_error_code() で記録します。
+ *
+ * @code
+ * static LatencySite site("db.query");
+ * auto rows = timed(site, [&] { return db.query(sql); });
+ * @endcode
+ */
+template <typename F>
+auto timed(LatencySite& site, F&& f) -> decltype(f()) {
+  std::uint64_t start = detail::latency_now();
+  auto result = f();
+  site.record(result.is_ok(), detail::latency_now() - start);
+  using E = std::decay_t<decltype(result.unchecked_err())>;
+  if constexpr (detail::has_error_code_v<E>) {
+    if (result.is_err()) {
+      site.record_error_code(detail::error_code_of(result.unchecked_err()));
+    }
+  }
+  return result;
+}
+
+}  // namespace t9_result
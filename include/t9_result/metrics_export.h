@@ -0,0 +1,556 @@
+#pragma once
+
+#if !defined(__linux__)
+#error "metrics_export.h is only available on Linux"
+#endif
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "latency.h"
+#include "result.h"
+
+namespace t9_result {
+
+/**
+ * @brief メトリクスの出力形式
+ */
+enum class MetricsFormat {
+  Prometheus,  ///< Prometheus のテキスト形式
+  Json,        ///< JSON
+};
+
+/**
+ * @brief メトリクス出力のシステムエラー
+ */
+struct ExportError {
+  const char* m_operation;  ///< 失敗したシステムコール名
+  int m_errno;              ///< errno の値
+};
+
+namespace detail {
+
+inline void append_uint(std::string& out, std::uint64_t value) {
+  char buffer[20];
+  auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  (void)ec;
+  out.append(buffer, end);
+}
+
+// Prometheus のラベル値と JSON の文字列で共通のエスケープ
+inline void append_escaped(std::string& out, const char* text) {
+  for (const char* p = text; *p; ++p) {
+    switch (*p) {
+      case '\\':
+        out += "\\\\";
+        break;
+      case '"':
+        out += "\\\"";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      default:
+        if (static_cast<unsigned char>(*p) < 0x20) {
+          // その他の制御文字は \u00XX とする
+          constexpr char kHex[] = "0123456789abcdef";
+          out += "\\u00";
+          out += kHex[(*p >> 4) & 0xf];
+          out += kHex[*p & 0xf];
+        } else {
+          out += *p;
+        }
+        break;
+    }
+  }
+}
+
+// ヒストグラムの le は 2^4-1 ナノ秒から4倍ごとの固定の境界とする
+// （LatencyHistogram のバケットは2のべき乗の境界をまたがないため正確）
+constexpr std::uint32_t kPrometheusFirstExponent = 4;
+constexpr std::uint32_t kPrometheusExponentStep = 2;
+
+// メトリクスごとにまとめて出力するための書き出し先
+struct PrometheusText {
+  std::string m_calls;
+  std::string m_errors;
+  std::string m_latency;
+};
+
+inline void append_site_label(std::string& out, const char* site) {
+  out += "{site=\"";
+  append_escaped(out, site);
+  out += '"';
+}
+
+inline void append_calls(std::string& out, const char* site,
+                         const char* outcome,
+                         const LatencyHistogram& histogram) {
+  out += "t9_result_calls_total";
+  append_site_label(out, site);
+  out += ",outcome=\"";
+  out += outcome;
+  out += "\"} ";
+  append_uint(out, histogram.count());
+  out += '\n';
+}
+
+inline void append_latency(std::string& out, const char* site,
+                           const char* outcome,
+                           const LatencyHistogram& histogram) {
+  auto labels = [&] {
+    append_site_label(out, site);
+    out += ",outcome=\"";
+    out += outcome;
+    out += '"';
+  };
+
+  // スクレイプごとに系列が変わらないよう、件数0の境界も出力する
+  std::uint64_t cumulative = 0;
+  std::size_t bucket = 0;
+  for (std::uint32_t exponent = kPrometheusFirstExponent;
+       exponent <= LatencyHistogram::kMaxExponent;
+       exponent += kPrometheusExponentStep) {
+    std::uint64_t bound = (std::uint64_t{1} << exponent) - 1;
+    while (bucket < LatencyHistogram::kBucketCount &&
+           LatencyHistogram::upper_bound_of(bucket) <= bound) {
+      cumulative += histogram.bucket_count(bucket);
+      ++bucket;
+    }
+    out += "t9_result_latency_nanoseconds_bucket";
+    labels();
+    out += ",le=\"";
+    append_uint(out, bound);
+    out += "\"} ";
+    append_uint(out, cumulative);
+    out += '\n';
+  }
+  out += "t9_result_latency_nanoseconds_bucket";
+  labels();
+  out += ",le=\"+Inf\"} ";
+  append_uint(out, histogram.count());
+  out += "\nt9_result_latency_nanoseconds_sum";
+  labels();
+  out += "} ";
+  append_uint(out, histogram.sum());
+  out += "\nt9_result_latency_nanoseconds_count";
+  labels();
+  out += "} ";
+  append_uint(out, histogram.count());
+  out += '\n';
+}
+
+inline void append_prometheus(PrometheusText& out, const char* site,
+                              const LatencySite::Snapshot& snapshot) {
+  append_calls(out.m_calls, site, "ok", snapshot.m_ok);
+  append_calls(out.m_calls, site, "err", snapshot.m_err);
+
+  // コードごとの件数は一度でも記録されたものを出力する
+  for (std::size_t i = 0; i <= LatencySite::kErrorCodeCount; ++i) {
+    std::uint64_t n = snapshot.m_error_codes[i];
+    if (n == 0) {
+      continue;
+    }
+    out.m_errors += "t9_result_errors_total";
+    append_site_label(out.m_errors, site);
+    out.m_errors += ",code=\"";
+    if (i < LatencySite::kErrorCodeCount) {
+      append_uint(out.m_errors, i);
+    } else {
+      out.m_errors += "other";
+    }
+    out.m_errors += "\"} ";
+    append_uint(out.m_errors, n);
+    out.m_errors += '\n';
+  }
+
+  append_latency(out.m_latency, site, "ok", snapshot.m_ok);
+  append_latency(out.m_latency, site, "err", snapshot.m_err);
+}
+
+inline void append_json(std::string& out, const LatencyHistogram& histogram) {
+  out += "{\"count\":";
+  append_uint(out, histogram.count());
+  out += ",\"sum\":";
+  append_uint(out, histogram.sum());
+  out += ",\"max\":";
+  append_uint(out, histogram.max());
+  out += ",\"p50\":";
+  append_uint(out, histogram.percentile(0.5));
+  out += ",\"p99\":";
+  append_uint(out, histogram.percentile(0.99));
+  // [バケットの上限値, 件数] の配列（件数0のバケットは省略）
+  out += ",\"buckets\":[";
+  bool first = true;
+  for (std::size_t i = 0; i < LatencyHistogram::kBucketCount; ++i) {
+    std::uint64_t n = histogram.bucket_count(i);
+    if (n == 0) {
+      continue;
+    }
+    if (!first) {
+      out += ',';
+    }
+    first = false;
+    out += '[';
+    append_uint(out, LatencyHistogram::upper_bound_of(i));
+    out += ',';
+    append_uint(out, n);
+    out += ']';
+  }
+  out += "]}";
+}
+
+inline void append_json_error_codes(std::string& out,
+                                   const LatencySite::Snapshot& snapshot) {
+  // {"コード": 件数}（件数0のコードは省略、範囲外のコードは "other"）
+  out += '{';
+  bool first = true;
+  for (std::size_t i = 0; i <= LatencySite::kErrorCodeCount; ++i) {
+    std::uint64_t n = snapshot.m_error_codes[i];
+    if (n == 0) {
+      continue;
+    }
+    if (!first) {
+      out += ',';
+    }
+    first = false;
+    out += '"';
+    if (i < LatencySite::kErrorCodeCount) {
+      append_uint(out, i);
+    } else {
+      out += "other";
+    }
+    out += "\":";
+    append_uint(out, n);
+  }
+  out += '}';
+}
+
+// ファイルへの書き出し用（ソケットへは MetricsExporter::send_to_client）
+inline Result<void, ExportError> write_all(int fd, const std::string& text) {
+  std::size_t written = 0;
+  while (written < text.size()) {
+    ssize_t n = ::write(fd, text.data() + written, text.size() - written);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return make_err(ExportError{"write", errno});
+    }
+    written += static_cast<std::size_t>(n);
+  }
+  return make_ok();
+}
+
+}  // namespace detail
+
+/**
+ * @brief 登録されているすべての LatencySite をテキストに変換
+ * @param format 出力形式
+ * @param out 出力先（末尾に追記）
+ *
+ * 呼び出し箇所ごとに LatencySite::snapshot() で全スレッドの集計を
+ * 合算しながら書き出します。記録中のスレッドとはロックを共有しないため、
+ * 変換中も記録は止まりません（LatencySite の生成・破棄のみ待機します）。
+ *
+ * Prometheus 形式では呼び出し箇所を site ラベルとし、以下のメトリクスを
+ * それぞれ # HELP と # TYPE に続けてまとめて出力します。
+ * - t9_result_calls_total（counter、成功・失敗を outcome ラベル）
+ * - t9_result_errors_total（counter、失敗値のコードを code ラベル）
+ * - t9_result_latency_nanoseconds（histogram、outcome ラベル）
+ *
+ * ヒストグラムの le は固定の境界で、件数0のバケットも出力します。
+ */
+inline void format_metrics(MetricsFormat format, std::string& out) {
+  if (format == MetricsFormat::Prometheus) {
+    detail::PrometheusText text;
+    LatencyRegistry::instance().for_each([&text](LatencySite& site) {
+      detail::append_prometheus(text, site.name(), site.snapshot());
+    });
+    out += "# HELP t9_result_calls_total Calls returning Result.\n"
+           "# TYPE t9_result_calls_total counter\n";
+    out += text.m_calls;
+    out += "# HELP t9_result_errors_total Failed calls by error code.\n"
+           "# TYPE t9_result_errors_total counter\n";
+    out += text.m_errors;
+    out += "# HELP t9_result_latency_nanoseconds Latency of calls returning "
+           "Result.\n"
+           "# TYPE t9_result_latency_nanoseconds histogram\n";
+    out += text.m_latency;
+    return;
+  }
+
+  bool first = true;
+  out += "{\"sites\":[";
+  LatencyRegistry::instance().for_each([&](LatencySite& site) {
+    LatencySite::Snapshot snapshot = site.snapshot();
+    if (!first) {
+      out += ',';
+    }
+    first = false;
+    out += "{\"name\":\"";
+    detail::append_escaped(out, site.name());
+    out += "\",\"ok\":";
+    detail::append_json(out, snapshot.m_ok);
+    out += ",\"err\":";
+    detail::append_json(out, snapshot.m_err);
+    out += ",\"error_codes\":";
+    detail::append_json_error_codes(out, snapshot);
+    out += '}';
+  });
+  out += "]}\n";
+}
+
+/**
+ * @brief メトリクスをファイルに書き出す
+ * @param path 出力先のパス
+ * @param format 出力形式
+ * @return Result<void, ExportError> 書き込みに失敗した場合はエラー
+ *
+ * 一時ファイルに書き込んでから rename するため、読み込み側が
+ * 書きかけの内容を読むことはありません。
+ */
+inline Result<void, ExportError> write_metrics_file(const std::string& path,
+                                                    MetricsFormat format) {
+  std::string text;
+  format_metrics(format, text);
+  std::string temporary = path + ".tmp";
+  int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                  0644);
+  if (fd < 0) {
+    return make_err(ExportError{"open", errno});
+  }
+  auto written = detail::write_all(fd, text);
+  ::close(fd);
+  if (written.is_err()) {
+    ::unlink(temporary.c_str());
+    return written;
+  }
+  if (::rename(temporary.c_str(), path.c_str()) != 0) {
+    ExportError error{"rename", errno};
+    ::unlink(temporary.c_str());
+    return make_err(error);
+  }
+  return make_ok();
+}
+
+/**
+ * @brief メトリクスを定期的にファイルへ、要求に応じてソケットへ書き出す
+ *
+ * start() でバックグラウンドスレッドを起動し、以下を行います。
+ * - m_file_path が空でなければ m_interval ごとに write_metrics_file()
+ * - m_socket_path が空でなければ Unix ドメインソケットで待ち受け、
+ *   接続ごとにその時点のメトリクスを書き出して切断（m_send_timeout 以内に
+ *   書き出せない場合は打ち切る）
+ *
+ * 集計はバックグラウンドスレッドで行うため、記録するスレッドは
+ * 出力の影響を受けません。デストラクタでスレッドを停止します。
+ */
+class MetricsExporter final {
+ public:
+  /**
+   * @brief 出力の設定
+   */
+  struct Options {
+    MetricsFormat m_format = MetricsFormat::Prometheus;
+    std::string m_file_path;    ///< 定期的に書き出すファイル（空なら無効）
+    std::string m_socket_path;  ///< 待ち受けるソケット（空なら無効）
+    std::chrono::milliseconds m_interval{1000};  ///< ファイルの更新間隔
+    /// 1回の接続への書き出しに掛ける時間の上限
+    std::chrono::milliseconds m_send_timeout{1000};
+  };
+
+ private:
+  Options m_options;
+  int m_listen_fd = -1;
+  int m_stop_fds[2] = {-1, -1};
+  std::thread m_thread;
+
+  void close_fds() {
+    if (m_listen_fd >= 0) {
+      ::close(m_listen_fd);
+      ::unlink(m_options.m_socket_path.c_str());
+      m_listen_fd = -1;
+    }
+    for (int& fd : m_stop_fds) {
+      if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+      }
+    }
+  }
+
+  Result<void, ExportError> listen_socket() {
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (m_options.m_socket_path.size() >= sizeof(address.sun_path)) {
+      return make_err(ExportError{"bind", ENAMETOOLONG});
+    }
+    std::memcpy(address.sun_path, m_options.m_socket_path.c_str(),
+                m_options.m_socket_path.size() + 1);
+    m_listen_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_listen_fd < 0) {
+      return make_err(ExportError{"socket", errno});
+    }
+    // 前回のプロセスが残したソケットファイルは置き換える
+    ::unlink(m_options.m_socket_path.c_str());
+    if (::bind(m_listen_fd, reinterpret_cast<sockaddr*>(&address),
+               sizeof(address)) != 0) {
+      return make_err(ExportError{"bind", errno});
+    }
+    if (::listen(m_listen_fd, 16) != 0) {
+      return make_err(ExportError{"listen", errno});
+    }
+    return make_ok();
+  }
+
+  // 読み出さない相手でスレッドが止まらないよう、ノンブロッキングで書き込み
+  // m_send_timeout を過ぎるか停止を要求された時点で打ち切る
+  void send_to_client(int client, const std::string& text) {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point deadline = Clock::now() + m_options.m_send_timeout;
+    std::size_t written = 0;
+    while (written < text.size()) {
+      ssize_t n = ::send(client, text.data() + written, text.size() - written,
+                         MSG_NOSIGNAL);
+      if (n >= 0) {
+        written += static_cast<std::size_t>(n);
+        continue;
+      }
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        return;
+      }
+      auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+          deadline - Clock::now());
+      if (remaining.count() <= 0) {
+        return;
+      }
+      pollfd fds[2] = {{client, POLLOUT, 0}, {m_stop_fds[0], POLLIN, 0}};
+      if (::poll(fds, 2, static_cast<int>(remaining.count())) < 0 &&
+          errno != EINTR) {
+        return;
+      }
+      if (fds[1].revents) {
+        return;
+      }
+    }
+  }
+
+  void serve_client() {
+    int client = ::accept4(m_listen_fd, nullptr, nullptr,
+                           SOCK_CLOEXEC | SOCK_NONBLOCK);
+    if (client < 0) {
+      return;
+    }
+    std::string text;
+    format_metrics(m_options.m_format, text);
+    // 相手が先に切断した場合などの失敗は次の接続に影響しないため無視する
+    send_to_client(client, text);
+    ::close(client);
+  }
+
+  void run() {
+    using Clock = std::chrono::steady_clock;
+    bool has_file = !m_options.m_file_path.empty();
+    Clock::time_point next = Clock::now();
+    for (;;) {
+      int timeout = -1;
+      if (has_file) {
+        auto now = Clock::now();
+        if (now >= next) {
+          // 書き込みの失敗は次の周期で再試行する
+          (void)write_metrics_file(m_options.m_file_path, m_options.m_format);
+          next = now + m_options.m_interval;
+        }
+        timeout = static_cast<int>(
+            std::chrono::ceil<std::chrono::milliseconds>(next - Clock::now())
+                .count());
+      }
+      pollfd fds[2] = {{m_stop_fds[0], POLLIN, 0}, {m_listen_fd, POLLIN, 0}};
+      int ready = ::poll(fds, m_listen_fd >= 0 ? 2 : 1, timeout);
+      if (ready < 0 && errno != EINTR) {
+        return;
+      }
+      if (fds[0].revents) {
+        return;
+      }
+      if (m_listen_fd >= 0 && (fds[1].revents & POLLIN)) {
+        serve_client();
+      }
+    }
+  }
+
+ public:
+  MetricsExporter() = default;
+
+  MetricsExporter(const MetricsExporter&) = delete;
+  MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+  ~MetricsExporter() {
+    stop();
+  }
+
+  /**
+   * @brief 出力を開始
+   * @param options 出力の設定
+   * @return Result<void, ExportError> ソケットの準備に失敗した場合はエラー
+   * @note 既に開始している場合はアサーション違反
+   */
+  Result<void, ExportError> start(Options options) {
+    assert(!m_thread.joinable());
+    m_options = std::move(options);
+    if (::pipe2(m_stop_fds, O_CLOEXEC) != 0) {
+      return make_err(ExportError{"pipe2", errno});
+    }
+    if (!m_options.m_socket_path.empty()) {
+      auto listened = listen_socket();
+      if (listened.is_err()) {
+        close_fds();
+        return listened;
+      }
+    }
+    m_thread = std::thread([this] { run(); });
+    return make_ok();
+  }
+
+  /**
+   * @brief 出力を停止
+   *
+   * ソケットファイルは削除し、出力済みのファイルは残します。
+   */
+  void stop() {
+    if (m_thread.joinable()) {
+      char byte = 0;
+      while (::write(m_stop_fds[1], &byte, 1) < 0 && errno == EINTR) {
+      }
+      m_thread.join();
+    }
+    close_fds();
+  }
+};
+
+}  // namespace t9_result
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "result.h"
+
+namespace t9_result {
+
+namespace detail {
+
+template <typename T, typename... Ts>
+constexpr bool contains_v = (std::is_same_v<T, Ts> || ...);
+
+template <typename T, typename... Ts>
+constexpr std::size_t index_of() {
+  constexpr bool matches[] = {std::is_same_v<T, Ts>...};
+  for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+    if (matches[i]) {
+      return i;
+    }
+  }
+  return sizeof...(Ts);
+}
+
+template <typename... Ts>
+constexpr bool is_unique_v = true;
+
+template <typename T, typename... Ts>
+constexpr bool is_unique_v<T, Ts...> =
+    !contains_v<T, Ts...> && is_unique_v<Ts...>;
+
+template <typename... Ts>
+constexpr std::size_t max_size_v = 0;
+
+template <typename T, typename... Ts>
+constexpr std::size_t max_size_v<T, Ts...> =
+    sizeof(T) > max_size_v<Ts...> ? sizeof(T) : max_size_v<Ts...>;
+
+}  // namespace detail
+
+/**
+ * @brief 複数の失敗値の型のいずれかを保持する型
+ * @tparam Es 失敗値の型（重複なし、255種類まで）
+ *
+ * Result<T, OneOf<E1, E2>> のように使用し、異なる失敗値を返す関数を
+ * 共通の大きなエラー型へ map_err せずに合成できます。
+ *
+ * 判別子は1バイトで、失敗値の型の集合を広げる変換
+ * （E1 や OneOf<E1, E2> から OneOf<E1, E2, E3> への変換）は暗黙に行えます。
+ * 変換は判別子の付け替えと失敗値の1回のムーブで、すべての型が
+ * トリビアルコピー可能な場合は領域のコピーのみで行います。
+ * Result の変換コンストラクタと組み合わせることで、
+ * Result<T, E1> をそのまま Result<T, OneOf<E1, E2>> として返せます。
+ */
+template <typename... Es>
+class OneOf final {
+  static_assert(sizeof...(Es) > 0, "OneOf requires at least one type");
+  static_assert(sizeof...(Es) < 256, "OneOf supports up to 255 types");
+  static_assert(detail::is_unique_v<Es...>, "OneOf types must be unique");
+  static_assert((std::is_same_v<Es, std::decay_t<Es>> && ...),
+                "OneOf types must not be references or cv-qualified");
+
+  template <typename...>
+  friend class OneOf;
+
+ private:
+  static constexpr bool kTrivial =
+      (std::is_trivially_copyable_v<Es> && ...);
+
+  alignas(Es...) unsigned char m_storage[detail::max_size_v<Es...>];
+  std::uint8_t m_index;
+
+  template <typename E>
+  static constexpr std::size_t index_of = detail::index_of<E, Es...>();
+
+  template <typename Self, typename E>
+  using Qualified = std::conditional_t<std::is_const_v<Self>, const E, E>;
+
+  template <typename Self, typename F>
+  using VisitResult = std::common_type_t<decltype(std::declval<F&>()(
+      std::declval<Qualified<Self, Es>&>()))...>;
+
+  // 判別子を先頭から順に比較して該当する型で f を呼び出す
+  template <std::size_t I, typename Self, typename F>
+  static VisitResult<Self, F> visit_at(Self& self, F& f) {
+    using E = Qualified<Self, std::tuple_element_t<I, std::tuple<Es...>>>;
+    if constexpr (I + 1 == sizeof...(Es)) {
+      return f(*std::launder(reinterpret_cast<E*>(self.m_storage)));
+    } else {
+      if (self.m_index == I) {
+        return f(*std::launder(reinterpret_cast<E*>(self.m_storage)));
+      }
+      return visit_at<I + 1>(self, f);
+    }
+  }
+
+  void destroy() {
+    if constexpr (!(std::is_trivially_destructible_v<Es> && ...)) {
+      visit([](auto& value) {
+        using V = std::decay_t<decltype(value)>;
+        value.~V();
+      });
+    }
+  }
+
+  template <typename Other>
+  void construct_from(Other&& other) {
+    if constexpr (kTrivial) {
+      std::memcpy(m_storage, other.m_storage, sizeof(other.m_storage));
+      m_index = other.m_index;
+    } else {
+      m_index = other.m_index;
+      other.visit([this](auto& value) {
+        using V = std::decay_t<decltype(value)>;
+        if constexpr (std::is_rvalue_reference_v<Other&&>) {
+          new (m_storage) V(std::move(value));
+        } else {
+          new (m_storage) V(value);
+        }
+      });
+    }
+  }
+
+ public:
+  /**
+   * @brief 失敗値から生成するコンストラクタ
+   * @tparam E 失敗値の型（Es のいずれか）
+   * @param value 失敗値
+   */
+  template <typename E,
+            std::enable_if_t<detail::contains_v<std::decay_t<E>, Es...>,
+                             int> = 0>
+  OneOf(E&& value)
+      : m_index(static_cast<std::uint8_t>(index_of<std::decay_t<E>>)) {
+    new (m_storage) std::decay_t<E>(std::forward<E>(value));
+  }
+
+  /**
+   * @brief より少ない型の OneOf から広げるコンストラクタ
+   * @tparam Fs 変換元の失敗値の型（すべて Es に含まれること）
+   * @param other 変換元
+   */
+  template <typename... Fs,
+            std::enable_if_t<!std::is_same_v<OneOf<Fs...>, OneOf> &&
+                                 (detail::contains_v<Fs, Es...> && ...),
+                             int> = 0>
+  OneOf(OneOf<Fs...>&& other) {
+    // 変換元の判別子から変換先の判別子への対応表
+    static constexpr std::uint8_t kRemap[] = {
+        static_cast<std::uint8_t>(index_of<Fs>)...};
+    if constexpr (OneOf<Fs...>::kTrivial) {
+      std::memcpy(m_storage, other.m_storage, sizeof(other.m_storage));
+    } else {
+      other.visit([this](auto& value) {
+        using V = std::decay_t<decltype(value)>;
+        new (m_storage) V(std::move(value));
+      });
+    }
+    m_index = kRemap[other.m_index];
+  }
+
+  /**
+   * @brief より少ない型の OneOf から広げるコンストラクタ（コピー）
+   * @see OneOf(OneOf<Fs...>&&)
+   */
+  template <typename... Fs,
+            std::enable_if_t<!std::is_same_v<OneOf<Fs...>, OneOf> &&
+                                 (detail::contains_v<Fs, Es...> && ...),
+                             int> = 0>
+  OneOf(const OneOf<Fs...>& other) : OneOf(OneOf<Fs...>(other)) {}
+
+  OneOf(const OneOf& other) {
+    construct_from(other);
+  }
+
+  OneOf(OneOf&& other) {
+    construct_from(std::move(other));
+  }
+
+  OneOf& operator=(const OneOf& other) {
+    if (this != &other) {
+      destroy();
+      construct_from(other);
+    }
+    return *this;
+  }
+
+  OneOf& operator=(OneOf&& other) {
+    if (this != &other) {
+      destroy();
+      construct_from(std::move(other));
+    }
+    return *this;
+  }
+
+  ~OneOf() {
+    destroy();
+  }
+
+  /**
+   * @brief 保持している型の番号を取得
+   * @return std::size_t Es における位置
+   */
+  std::size_t index() const {
+    return m_index;
+  }
+
+  /**
+   * @brief 指定した型の失敗値を保持しているか確認
+   * @tparam E 確認する型
+   * @return bool 保持している場合true
+   */
+  template <typename E>
+  bool holds() const {
+    static_assert(detail::contains_v<E, Es...>, "E is not in OneOf");
+    return m_index == index_of<E>;
+  }
+
+  /**
+   * @brief 指定した型の失敗値へのポインタを取得
+   * @tparam E 取得する型
+   * @return E* 保持していない場合 nullptr
+   */
+  template <typename E>
+  E* get_if() {
+    return holds<E>() ? std::launder(reinterpret_cast<E*>(m_storage))
+                      : nullptr;
+  }
+
+  template <typename E>
+  const E* get_if() const {
+    return holds<E>()
+               ? std::launder(reinterpret_cast<const E*>(m_storage))
+               : nullptr;
+  }
+
+  /**
+   * @brief 指定した型の失敗値への参照を取得
+   * @tparam E 取得する型
+   * @return E& 失敗値への参照
+   * @note 保持していない場合はアサーション違反
+   */
+  template <typename E>
+  E& get() {
+    assert(holds<E>());
+    return *std::launder(reinterpret_cast<E*>(m_storage));
+  }
+
+  template <typename E>
+  const E& get() const {
+    assert(holds<E>());
+    return *std::launder(reinterpret_cast<const E*>(m_storage));
+  }
+
+  /**
+   * @brief 保持している失敗値に関数を適用
+   * @tparam F すべての失敗値の型を受け取れる関数の型
+   * @param f 適用する関数
+   * @return 各呼び出しの戻り値型の共通型
+   */
+  template <typename F>
+  VisitResult<OneOf, F> visit(F&& f) {
+    return visit_at<0>(*this, f);
+  }
+
+  template <typename F>
+  VisitResult<const OneOf, F> visit(F&& f) const {
+    return visit_at<0>(*this, f);
+  }
+};
+
+}  // namespace t9_result
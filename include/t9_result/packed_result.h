@@ -0,0 +1,262 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "result.h"
+
+namespace t9_result {
+
+/**
+ * @brief 値の表現に必要なビット数を定義するトレイト
+ * @tparam T 対象の型
+ *
+ * PackedResult で使用する型はこのテンプレートを特殊化し、
+ * static constexpr unsigned value を定義します。
+ * void（0）、bool（1）、整数型（型のビット数）は定義済みです。
+ * 列挙型は列挙子の最大値を表せるビット数を指定してください。
+ *
+ * 列挙型の値は基底型によらず符号なしとして格納します。負の列挙子を
+ * 持つ場合は static constexpr bool is_signed = true も定義し、
+ * 符号ビットを含めたビット数を value に指定してください。
+ */
+template <typename T, typename = void>
+struct BitWidth;
+
+template <>
+struct BitWidth<void> {
+  static constexpr unsigned value = 0;
+};
+
+template <>
+struct BitWidth<bool> {
+  static constexpr unsigned value = 1;
+};
+
+template <typename T>
+struct BitWidth<T, std::enable_if_t<std::is_integral_v<T> &&
+                                    !std::is_same_v<T, bool>>> {
+  static constexpr unsigned value =
+      std::numeric_limits<T>::digits + std::is_signed_v<T>;
+};
+
+namespace detail {
+
+template <unsigned Bits>
+using PackedStorage = std::conditional_t<
+    Bits <= 8, std::uint8_t,
+    std::conditional_t<
+        Bits <= 16, std::uint16_t,
+        std::conditional_t<Bits <= 32, std::uint32_t, std::uint64_t>>>;
+
+template <typename T, bool = std::is_enum_v<T>>
+struct PackedInteger {
+  using type = T;
+};
+
+template <typename T>
+struct PackedInteger<T, true> {
+  using type = std::underlying_type_t<T>;
+};
+
+// BitWidth が is_signed を定義していればそれに、なければ型に従う
+template <typename T, typename = void>
+struct PackedSigned : std::bool_constant<std::is_signed_v<T>> {};
+
+template <typename T>
+struct PackedSigned<T, std::void_t<decltype(BitWidth<T>::is_signed)>>
+    : std::bool_constant<BitWidth<T>::is_signed> {};
+
+template <typename T>
+struct PackedCodec {
+  static constexpr unsigned kWidth = BitWidth<T>::value;
+
+  using Integer = typename PackedInteger<T>::type;
+
+  static constexpr std::uint64_t encode(T value) {
+    auto integer = static_cast<Integer>(value);
+    auto bits = static_cast<std::uint64_t>(integer);
+    if constexpr (kWidth < 64) {
+      bits &= (std::uint64_t{1} << kWidth) - 1;
+    }
+    return bits;
+  }
+
+  static constexpr T decode(std::uint64_t bits) {
+    if constexpr (PackedSigned<T>::value && kWidth < 64) {
+      // 符号拡張
+      std::uint64_t sign = std::uint64_t{1} << (kWidth - 1);
+      bits = (bits ^ sign) - sign;
+    }
+    return static_cast<T>(static_cast<Integer>(bits));
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief 判別子と値を1つの整数に詰めたResult
+ * @tparam T 成功値の型（void、bool、整数型、列挙型）
+ * @tparam E 失敗値の型（bool、整数型、列挙型）
+ *
+ * 最下位ビットを判別子（1 が成功）とし、その上に BitWidth で
+ * 指定したビット数の値を格納します。格納先は必要なビット数を表せる
+ * 最小の符号なし整数型で、例えば BitWidth<Reason> が 7 であれば
+ * PackedResult<bool, Reason> は1バイトです。
+ *
+ * 大量の検査結果を配列に保持する場合など、Result<T, E> の
+ * 判別子とパディングによるメモリ使用量を抑えたい場合に使用します。
+ * 値は参照ではなくコピーで取り出し、to_result() で Result に変換できます。
+ */
+template <typename T, typename E>
+class PackedResult final {
+  static_assert(std::is_void_v<T> || std::is_integral_v<T> ||
+                    std::is_enum_v<T>,
+                "T must be void, integral or enum");
+  static_assert(std::is_integral_v<E> || std::is_enum_v<E>,
+                "E must be integral or enum");
+
+ public:
+  /// 判別子を含む使用ビット数
+  static constexpr unsigned kBits =
+      1 + (BitWidth<T>::value > BitWidth<E>::value ? BitWidth<T>::value
+                                                    : BitWidth<E>::value);
+  static_assert(kBits <= 64, "T and E must fit in 63 bits");
+
+  using Storage = detail::PackedStorage<kBits>;
+
+ private:
+  Storage m_bits;
+
+  struct RawTag {};
+
+  constexpr PackedResult(RawTag, Storage bits) : m_bits(bits) {}
+
+  template <typename U>
+  static constexpr Storage pack(U value, Storage tag) {
+    std::uint64_t bits = detail::PackedCodec<U>::encode(value);
+    // 指定したビット数に収まらない値はアサーション違反
+    assert(detail::PackedCodec<U>::decode(bits) == value);
+    return static_cast<Storage>((bits << 1) | tag);
+  }
+
+ public:
+  /**
+   * @brief 成功値から生成するコンストラクタ
+   * @param ok 成功値をラップしたOk型
+   */
+  PackedResult(Ok<T> ok) : m_bits(1) {
+    if constexpr (!std::is_void_v<T>) {
+      m_bits = pack(ok.m_value, 1);
+    } else {
+      (void)ok;
+    }
+  }
+
+  /**
+   * @brief 失敗値から生成するコンストラクタ
+   * @param err 失敗値をラップしたErr型
+   */
+  PackedResult(Err<E> err) : m_bits(pack(err.m_value, 0)) {}
+
+  /**
+   * @brief Result から変換するコンストラクタ
+   * @param result 変換元
+   */
+  explicit PackedResult(const Result<T, E>& result) : m_bits(0) {
+    if (result.is_ok()) {
+      if constexpr (std::is_void_v<T>) {
+        m_bits = 1;
+      } else {
+        m_bits = pack(result.unchecked_ok(), 1);
+      }
+    } else {
+      m_bits = pack(result.unchecked_err(), 0);
+    }
+  }
+
+  /**
+   * @brief 格納している整数から復元
+   * @param bits raw() で取得した値
+   * @return PackedResult 復元した値
+   */
+  static constexpr PackedResult from_raw(Storage bits) {
+    return PackedResult(RawTag{}, bits);
+  }
+
+  /**
+   * @brief 格納している整数を取得
+   * @return Storage 判別子と値を詰めた整数
+   */
+  constexpr Storage raw() const {
+    return m_bits;
+  }
+
+  constexpr bool is_ok() const {
+    return (m_bits & 1) != 0;
+  }
+
+  constexpr bool is_err() const {
+    return (m_bits & 1) == 0;
+  }
+
+  /**
+   * @brief 成功値を取得
+   * @return T 成功値
+   * @note 失敗値を保持している場合はアサーション違反
+   */
+  constexpr T unwrap() const {
+    assert(is_ok());
+    if constexpr (!std::is_void_v<T>) {
+      return detail::PackedCodec<T>::decode(m_bits >> 1);
+    }
+  }
+
+  /**
+   * @brief 成功値を取得、失敗時はデフォルト値を返す
+   * @param default_value 失敗時に返すデフォルト値
+   * @return T 成功値もしくはデフォルト値
+   */
+  template <typename U = T, std::enable_if_t<!std::is_void_v<U>, int> = 0>
+  constexpr T unwrap_or(U default_value) const {
+    return is_ok() ? detail::PackedCodec<T>::decode(m_bits >> 1)
+                   : default_value;
+  }
+
+  /**
+   * @brief 失敗値を取得
+   * @return E 失敗値
+   * @note 成功値を保持している場合はアサーション違反
+   */
+  constexpr E unwrap_err() const {
+    assert(is_err());
+    return detail::PackedCodec<E>::decode(m_bits >> 1);
+  }
+
+  /**
+   * @brief Result に変換
+   * @return Result<T, E> 同じ値を保持するResult
+   */
+  Result<T, E> to_result() const {
+    if (is_ok()) {
+      if constexpr (std::is_void_v<T>) {
+        return make_ok();
+      } else {
+        return Ok<T>(unwrap());
+      }
+    }
+    return Err<E>(unwrap_err());
+  }
+
+  friend constexpr bool operator==(PackedResult a, PackedResult b) {
+    return a.m_bits == b.m_bits;
+  }
+
+  friend constexpr bool operator!=(PackedResult a, PackedResult b) {
+    return a.m_bits != b.m_bits;
+  }
+};
+
+}  // namespace t9_result
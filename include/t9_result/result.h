@@ -1,8 +1,24 @@
 #pragma once
 
 #include <cassert>
+#include <type_traits>
+#include <utility>
 #include <variant>
 
+#include "result_fwd.h"
+
+/**
+ * @brief 条件が常に真であることをコンパイラに伝えるマクロ
+ *
+ * 判別子を一度検査した後の分岐で、再検査やエラーパスを生成させないために使用します。
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+#define T9_RESULT_ASSUME(cond) __assume(cond)
+#else
+#define T9_RESULT_ASSUME(cond) \
+  ((cond) ? static_cast<void>(0) : __builtin_unreachable())
+#endif
+
 namespace t9_result {
 
 /**
@@ -17,6 +33,65 @@ struct Ok {
   Ok(T&& value) : m_value(std::move(value)) {}
 };
 
+namespace detail {
+
+/**
+ * @brief 再束縛可能な参照
+ * @tparam T 参照先の型
+ *
+ * <functional> の std::reference_wrapper の代わりに使用します。
+ */
+template <typename T>
+class Reference {
+ private:
+  T* m_ptr;
+
+ public:
+  Reference(T& value) : m_ptr(&value) {}
+
+  operator T&() const {
+    return *m_ptr;
+  }
+
+  T& get() const {
+    return *m_ptr;
+  }
+};
+
+template <typename T>
+struct SingleElement {
+  T m_value[1];
+};
+
+/**
+ * @brief From から To への縮小変換を伴わない暗黙変換が可能か
+ *
+ * 配列要素のコピーリスト初期化は縮小変換を許さないことを利用します。
+ */
+template <typename From, typename To, typename = void>
+constexpr bool is_non_narrowing_convertible_v = false;
+
+template <typename From, typename To>
+constexpr bool is_non_narrowing_convertible_v<
+    From, To,
+    std::void_t<decltype(SingleElement<To>{{std::declval<From>()}})>> =
+    std::is_convertible_v<From, To>;
+
+}  // namespace detail
+
+/**
+ * @brief 参照型の成功値を表す型
+ * @tparam T 参照先の型
+ *
+ * 参照先を保持し、m_value は T& に暗黙変換されます。
+ */
+template <typename T>
+struct Ok<T&> {
+  detail::Reference<T> m_value;
+
+  Ok(T& value) : m_value(value) {}
+};
+
 /**
  * @brief void型の成功値を表す型
  */
@@ -44,6 +119,17 @@ inline Ok<void> make_ok() {
   return Ok<void>();
 }
 
+/**
+ * @brief 参照からOk型を生成するヘルパー関数
+ * @tparam T 参照先の型
+ * @param value 参照先
+ * @return Ok<T&> 参照をラップしたOk型
+ */
+template <typename T>
+inline Ok<T&> make_ok_ref(T& value) {
+  return value;
+}
+
 /**
  * @brief 引数から直接Ok型のオブジェクトを構築するヘルパー関数
  * @tparam T 構築する型
@@ -66,6 +152,31 @@ struct Err {
 
   Err(const T& value) : m_value(value) {}
   Err(T&& value) : m_value(std::move(value)) {}
+
+  /**
+   * @brief 変換可能な値から失敗値を直接構築するコンストラクタ
+   * @tparam U 変換元の型
+   * @param value 変換元の値
+   *
+   * Err<std::int8_t>(1000) のような縮小変換はコンパイルエラーになります。
+   */
+  template <typename U,
+            std::enable_if_t<
+                !std::is_same_v<std::decay_t<U>, T> &&
+                    !std::is_same_v<std::decay_t<U>, Err> &&
+                    detail::is_non_narrowing_convertible_v<U&&, T>,
+                int> = 0>
+  Err(U&& value) : m_value(std::forward<U>(value)) {}
+
+  // 縮小変換は Err(T&&) への暗黙変換で受け付けないよう削除する
+  template <typename U,
+            std::enable_if_t<
+                !std::is_same_v<std::decay_t<U>, T> &&
+                    !std::is_same_v<std::decay_t<U>, Err> &&
+                    std::is_convertible_v<U&&, T> &&
+                    !detail::is_non_narrowing_convertible_v<U&&, T>,
+                int> = 0>
+  Err(U&& value) = delete;
 };
 
 /**
@@ -116,6 +227,53 @@ class Result final {
    */
   Result(Err<E> err) : m_value(std::move(err)) {}
 
+  /**
+   * @brief 変換可能な失敗値からResultを生成するコンストラクタ
+   * @tparam E2 変換元の失敗値の型
+   * @param err 失敗値をラップしたErr型
+   *
+   * OneOf のように複数の失敗値を受け入れる型へ、失敗値を一度だけ
+   * 変換して格納します。変換元は呼び出し元の一時オブジェクトを
+   * 参照で受け取るため、Traced のように生成位置を記録する失敗値は
+   * 最適化の有無によらず呼び出し元のフレームを起点にできます。
+   */
+  template <typename E2,
+            std::enable_if_t<
+                !std::is_same_v<E2, E> &&
+                    detail::is_non_narrowing_convertible_v<E2&&, E>,
+                int> = 0>
+  Result(Err<E2>&& err)
+      : m_value(std::in_place_type<Err<E>>, std::move(err.m_value)) {}
+
+  template <typename E2,
+            std::enable_if_t<
+                !std::is_same_v<E2, E> &&
+                    detail::is_non_narrowing_convertible_v<const E2&, E>,
+                int> = 0>
+  Result(const Err<E2>& err)
+      : m_value(std::in_place_type<Err<E>>, err.m_value) {}
+
+  /**
+   * @brief 失敗値の型が異なるResultから変換するコンストラクタ
+   * @tparam E2 変換元の失敗値の型
+   * @param other 変換元のResult
+   *
+   * 成功値はそのままムーブし、失敗値は一度だけ変換して格納します。
+   */
+  template <typename E2,
+            std::enable_if_t<
+                !std::is_same_v<E2, E> &&
+                    detail::is_non_narrowing_convertible_v<E2&&, E>,
+                int> = 0>
+  Result(Result<T, E2>&& other) {
+    if (other.is_ok()) {
+      m_value.template emplace<Ok<T>>(
+          std::forward<T>(other.unchecked_ok()));
+    } else {
+      m_value.template emplace<Err<E>>(std::move(other.unchecked_err()));
+    }
+  }
+
   /**
    * @brief 成功値を保持しているか確認
    * @return bool 成功値を保持している場合true
@@ -149,7 +307,7 @@ class Result final {
    */
   T unwrap_or(T&& default_value) {
     if (is_ok()) {
-      return unwrap();
+      return std::forward<T>(unchecked_ok());
     }
     return std::forward<T>(default_value);
   }
@@ -204,6 +362,56 @@ class Result final {
     return std::get<Err<E>>(m_value).m_value;
   }
 
+  /**
+   * @brief 成功値への参照を検査なしで取得
+   * @return T& 成功値への参照
+   * @pre is_ok() が true であること
+   * @note デバッグビルドでは事前条件をアサーションで検証します。
+   *       リリースビルドでは判別子を検査せず、単純なロードになります。
+   */
+  T& unchecked_ok() {
+    assert(is_ok());
+    T9_RESULT_ASSUME(is_ok());
+    return std::get_if<Ok<T>>(&m_value)->m_value;
+  }
+
+  /**
+   * @brief 成功値への const 参照を検査なしで取得
+   * @return const T& 成功値への const 参照
+   * @pre is_ok() が true であること
+   * @see unchecked_ok
+   */
+  const T& unchecked_ok() const {
+    assert(is_ok());
+    T9_RESULT_ASSUME(is_ok());
+    return std::get_if<Ok<T>>(&m_value)->m_value;
+  }
+
+  /**
+   * @brief 失敗値への参照を検査なしで取得
+   * @return E& 失敗値への参照
+   * @pre is_err() が true であること
+   * @note デバッグビルドでは事前条件をアサーションで検証します。
+   *       リリースビルドでは判別子を検査せず、単純なロードになります。
+   */
+  E& unchecked_err() {
+    assert(is_err());
+    T9_RESULT_ASSUME(is_err());
+    return std::get_if<Err<E>>(&m_value)->m_value;
+  }
+
+  /**
+   * @brief 失敗値への const 参照を検査なしで取得
+   * @return const E& 失敗値への const 参照
+   * @pre is_err() が true であること
+   * @see unchecked_err
+   */
+  const E& unchecked_err() const {
+    assert(is_err());
+    T9_RESULT_ASSUME(is_err());
+    return std::get_if<Err<E>>(&m_value)->m_value;
+  }
+
   /**
    * @brief 成功値に関数を適用して新しいResult型を生成
    * @tparam F 適用する関数の型
@@ -217,9 +425,9 @@ class Result final {
   auto map(F&& f) -> Result<decltype(f(std::declval<T>())), E> {
     Result self = std::move(*this);
     if (self.is_ok()) {
-      return make_ok(f(std::get<Ok<T>>(self.m_value).m_value));
+      return make_ok(f(self.unchecked_ok()));
     }
-    return Err<E>(std::get<Err<E>>(self.m_value).m_value);
+    return Err<E>(std::move(self.unchecked_err()));
   }
 
   /**
@@ -235,9 +443,9 @@ class Result final {
   auto map_err(F&& f) -> Result<T, decltype(f(std::declval<E>()))> {
     Result self = std::move(*this);
     if (self.is_err()) {
-      return make_err(f(std::get<Err<E>>(self.m_value).m_value));
+      return make_err(f(self.unchecked_err()));
     }
-    return Ok<T>(std::get<Ok<T>>(self.m_value).m_value);
+    return Ok<T>(std::forward<T>(self.unchecked_ok()));
   }
 
   /**
@@ -251,7 +459,7 @@ class Result final {
   template <typename F>
   Result& inspect_ok(F&& f) {
     if (is_ok()) {
-      f(std::get<Ok<T>>(m_value).m_value);
+      f(unchecked_ok());
     }
     return *this;
   }
@@ -267,7 +475,7 @@ class Result final {
   template <typename F>
   Result& inspect_err(F&& f) {
     if (is_err()) {
-      f(std::get<Err<E>>(m_value).m_value);
+      f(unchecked_err());
     }
     return *this;
   }
@@ -285,9 +493,60 @@ class Result final {
   auto and_then(F&& f) -> decltype(f(std::declval<T>())) {
     Result self = std::move(*this);
     if (self.is_ok()) {
-      return f(std::get<Ok<T>>(self.m_value).m_value);
+      return f(self.unchecked_ok());
+    }
+    return Err<E>(std::move(self.unchecked_err()));
+  }
+
+  /**
+   * @brief 成功値・失敗値それぞれの関数で分岐する
+   * @tparam OnOk 成功時に適用する関数の型
+   * @tparam OnErr 失敗時に適用する関数の型
+   * @param on_ok 成功値を受け取る関数
+   * @param on_err 失敗値を受け取る関数
+   * @return 両関数の戻り値型の共通型
+   *
+   * 判別子の検査は一度だけ行われます。
+   * 値はResultの値カテゴリ（左辺値/const左辺値/右辺値）のまま渡されます。
+   */
+  template <typename OnOk, typename OnErr>
+  auto match(OnOk&& on_ok, OnErr&& on_err) & -> std::common_type_t<
+      decltype(on_ok(std::declval<T&>())),
+      decltype(on_err(std::declval<E&>()))> {
+    if (is_ok()) {
+      return on_ok(unchecked_ok());
+    }
+    return on_err(unchecked_err());
+  }
+
+  /**
+   * @brief 成功値・失敗値それぞれの関数で分岐する（const版）
+   * @see match
+   */
+  template <typename OnOk, typename OnErr>
+  auto match(OnOk&& on_ok, OnErr&& on_err) const& -> std::common_type_t<
+      decltype(on_ok(std::declval<const T&>())),
+      decltype(on_err(std::declval<const E&>()))> {
+    if (is_ok()) {
+      return on_ok(unchecked_ok());
+    }
+    return on_err(unchecked_err());
+  }
+
+  /**
+   * @brief 成功値・失敗値それぞれの関数で分岐する（右辺値版）
+   * @see match
+   *
+   * 値はムーブして渡されます。
+   */
+  template <typename OnOk, typename OnErr>
+  auto match(OnOk&& on_ok, OnErr&& on_err) && -> std::common_type_t<
+      decltype(on_ok(std::declval<T&&>())),
+      decltype(on_err(std::declval<E&&>()))> {
+    if (is_ok()) {
+      return on_ok(std::forward<T>(unchecked_ok()));
     }
-    return Err<E>(std::get<Err<E>>(self.m_value).m_value);
+    return on_err(std::move(unchecked_err()));
   }
 };
 
@@ -316,6 +575,52 @@ class Result<void, E> final {
    */
   Result(Err<E> err) : m_value(std::move(err)) {}
 
+  /**
+   * @brief 変換可能な失敗値からResultを生成するコンストラクタ
+   * @tparam E2 変換元の失敗値の型
+   * @param err 失敗値をラップしたErr型
+   *
+   * OneOf のように複数の失敗値を受け入れる型へ、失敗値を一度だけ
+   * 変換して格納します。変換元は呼び出し元の一時オブジェクトを
+   * 参照で受け取るため、Traced のように生成位置を記録する失敗値は
+   * 最適化の有無によらず呼び出し元のフレームを起点にできます。
+   */
+  template <typename E2,
+            std::enable_if_t<
+                !std::is_same_v<E2, E> &&
+                    detail::is_non_narrowing_convertible_v<E2&&, E>,
+                int> = 0>
+  Result(Err<E2>&& err)
+      : m_value(std::in_place_type<Err<E>>, std::move(err.m_value)) {}
+
+  template <typename E2,
+            std::enable_if_t<
+                !std::is_same_v<E2, E> &&
+                    detail::is_non_narrowing_convertible_v<const E2&, E>,
+                int> = 0>
+  Result(const Err<E2>& err)
+      : m_value(std::in_place_type<Err<E>>, err.m_value) {}
+
+  /**
+   * @brief 失敗値の型が異なるResultから変換するコンストラクタ
+   * @tparam E2 変換元の失敗値の型
+   * @param other 変換元のResult
+   *
+   * 成功値はそのままムーブし、失敗値は一度だけ変換して格納します。
+   */
+  template <typename E2,
+            std::enable_if_t<
+                !std::is_same_v<E2, E> &&
+                    detail::is_non_narrowing_convertible_v<E2&&, E>,
+                int> = 0>
+  Result(Result<void, E2>&& other) {
+    if (other.is_ok()) {
+      m_value.template emplace<Ok<void>>();
+    } else {
+      m_value.template emplace<Err<E>>(std::move(other.unchecked_err()));
+    }
+  }
+
   /**
    * @brief 成功状態を保持しているか確認
    * @return bool 成功状態を保持している場合true
@@ -370,6 +675,31 @@ class Result<void, E> final {
     return std::get<Err<E>>(m_value).m_value;
   }
 
+  /**
+   * @brief 失敗値への参照を検査なしで取得
+   * @return E& 失敗値への参照
+   * @pre is_err() が true であること
+   * @note デバッグビルドでは事前条件をアサーションで検証します。
+   *       リリースビルドでは判別子を検査せず、単純なロードになります。
+   */
+  E& unchecked_err() {
+    assert(is_err());
+    T9_RESULT_ASSUME(is_err());
+    return std::get_if<Err<E>>(&m_value)->m_value;
+  }
+
+  /**
+   * @brief 失敗値への const 参照を検査なしで取得
+   * @return const E& 失敗値への const 参照
+   * @pre is_err() が true であること
+   * @see unchecked_err
+   */
+  const E& unchecked_err() const {
+    assert(is_err());
+    T9_RESULT_ASSUME(is_err());
+    return std::get_if<Err<E>>(&m_value)->m_value;
+  }
+
   /**
    * @brief 成功時に関数を適用して新しいResult型を生成
    * @tparam F 適用する関数の型
@@ -385,7 +715,7 @@ class Result<void, E> final {
     if (self.is_ok()) {
       return make_ok(f());
     }
-    return Err<E>(std::get<Err<E>>(self.m_value).m_value);
+    return Err<E>(std::move(self.unchecked_err()));
   }
 
   /**
@@ -401,7 +731,7 @@ class Result<void, E> final {
   auto map_err(F&& f) -> Result<void, decltype(f(std::declval<E>()))> {
     Result self = std::move(*this);
     if (self.is_err()) {
-      return make_err(f(std::get<Err<E>>(self.m_value).m_value));
+      return make_err(f(self.unchecked_err()));
     }
     return Ok<void>();
   }
@@ -433,7 +763,7 @@ class Result<void, E> final {
   template <typename F>
   Result& inspect_err(F&& f) {
     if (is_err()) {
-      f(std::get<Err<E>>(m_value).m_value);
+      f(unchecked_err());
     }
     return *this;
   }
@@ -453,7 +783,54 @@ class Result<void, E> final {
     if (self.is_ok()) {
       return f();
     }
-    return Err<E>(std::get<Err<E>>(self.m_value).m_value);
+    return Err<E>(std::move(self.unchecked_err()));
+  }
+
+  /**
+   * @brief 成功時・失敗時それぞれの関数で分岐する
+   * @tparam OnOk 成功時に適用する関数の型
+   * @tparam OnErr 失敗時に適用する関数の型
+   * @param on_ok 成功時に呼び出す関数
+   * @param on_err 失敗値を受け取る関数
+   * @return 両関数の戻り値型の共通型
+   *
+   * 判別子の検査は一度だけ行われます。
+   */
+  template <typename OnOk, typename OnErr>
+  auto match(OnOk&& on_ok, OnErr&& on_err) & -> std::common_type_t<
+      decltype(on_ok()), decltype(on_err(std::declval<E&>()))> {
+    if (is_ok()) {
+      return on_ok();
+    }
+    return on_err(unchecked_err());
+  }
+
+  /**
+   * @brief 成功時・失敗時それぞれの関数で分岐する（const版）
+   * @see match
+   */
+  template <typename OnOk, typename OnErr>
+  auto match(OnOk&& on_ok, OnErr&& on_err) const& -> std::common_type_t<
+      decltype(on_ok()), decltype(on_err(std::declval<const E&>()))> {
+    if (is_ok()) {
+      return on_ok();
+    }
+    return on_err(unchecked_err());
+  }
+
+  /**
+   * @brief 成功時・失敗時それぞれの関数で分岐する（右辺値版）
+   * @see match
+   *
+   * 失敗値はムーブして渡されます。
+   */
+  template <typename OnOk, typename OnErr>
+  auto match(OnOk&& on_ok, OnErr&& on_err) && -> std::common_type_t<
+      decltype(on_ok()), decltype(on_err(std::declval<E&&>()))> {
+    if (is_ok()) {
+      return on_ok();
+    }
+    return on_err(std::move(unchecked_err()));
   }
 };
 
@@ -0,0 +1,45 @@
+#pragma once
+
+/**
+ * @file result_fwd.h
+ * @brief Result関連の型の前方宣言
+ *
+ * 関数宣言などで型名のみが必要な場合は、result.h の代わりにこのヘッダを
+ * インクルードすることで <variant> などの解析コストを避けられます。
+ */
+
+namespace t9_result {
+
+template <typename T>
+struct Ok;
+
+template <typename T>
+struct Err;
+
+template <typename T, typename E>
+class Result;
+
+}  // namespace t9_result
+
+/**
+ * @brief Result<T, E> の暗黙的インスタンス化を抑制するマクロ
+ * @param T 成功値の型
+ * @param E 失敗値の型
+ *
+ * よく使う組み合わせについてヘッダで宣言し、
+ * T9_RESULT_INSTANTIATE_TEMPLATE を記述した翻訳単位を一つだけ用意することで、
+ * メンバ関数のインスタンス化を各翻訳単位で繰り返さずに済みます。
+ * 使用する箇所では result.h をインクルードしておく必要があります。
+ * 型名にカンマを含む場合は別名を定義してから渡してください。
+ */
+#define T9_RESULT_EXTERN_TEMPLATE(T, E) \
+  extern template class ::t9_result::Result<T, E>
+
+/**
+ * @brief Result<T, E> を明示的にインスタンス化するマクロ
+ * @param T 成功値の型
+ * @param E 失敗値の型
+ * @see T9_RESULT_EXTERN_TEMPLATE
+ */
+#define T9_RESULT_INSTANTIATE_TEMPLATE(T, E) \
+  template class ::t9_result::Result<T, E>
@@ -0,0 +1,459 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include "result.h"
+
+namespace t9_result {
+
+/**
+ * @brief シリアライズ時のエラー
+ */
+enum class WireError {
+  BufferTooSmall,  ///< 書き込み先のバッファが不足している
+  Truncated,       ///< 読み込むバイト列が途中で終わっている
+  InvalidTag,      ///< タグが成功/失敗のいずれでもない
+  InvalidPayload,  ///< ペイロードの内容が不正
+};
+
+/**
+ * @brief ワイヤフォーマット先頭の1バイトのタグ
+ */
+enum class WireTag : std::uint8_t {
+  Ok = 1,
+  Err = 2,
+};
+
+/**
+ * @brief 任意のビット列が有効な値になる型かを表すトレイト
+ * @tparam T 対象の型
+ *
+ * bool を除く算術型とスコープ付き列挙型（基底型が固定されているため
+ * 基底型の任意の値が有効）は true です。
+ * すべてのメンバがこれを満たす構造体は特殊化して true にすると、
+ * 既定のCodecでエンコードできます。
+ * bool やポインタなど不正なビット列を持ちうる型を含めてはいけません。
+ */
+template <typename T, typename = void>
+struct AnyBitPattern
+    : std::bool_constant<(std::is_arithmetic_v<T> &&
+                          !std::is_same_v<T, bool>)> {};
+
+template <typename T>
+struct AnyBitPattern<T, std::enable_if_t<std::is_enum_v<T>>>
+    : std::bool_constant<
+          !std::is_convertible_v<T, std::underlying_type_t<T>>> {};
+
+/**
+ * @brief 値のエンコード・デコード方法を定義するトレイト
+ * @tparam T 対象の型
+ *
+ * ユーザー定義型はこのテンプレートを特殊化し、以下を定義します。
+ * - static constexpr bool is_fixed_size
+ * - static constexpr std::size_t fixed_size（is_fixed_size が true の場合）
+ * - static std::size_t encoded_size(const T& value)
+ * - static void encode(const T& value, std::byte* out)
+ *   （エンコードできない値がある場合は Result<void, WireError> を返し、
+ *   失敗時は何も書き込まない）
+ * - static Result<T, WireError> decode(const std::byte* data,
+ *                                      std::size_t size,
+ *                                      std::size_t& consumed)
+ *
+ * 既定の実装は AnyBitPattern を満たすトリビアルコピー可能かつ
+ * デフォルト構築可能な型をホストのバイトオーダーのまま memcpy します。
+ * プロセス間通信など同一マシン内での利用を想定しています。
+ */
+template <typename T, typename = void>
+struct Codec;
+
+/**
+ * @brief 任意のビット列が有効な型のCodec
+ * @tparam T 対象の型
+ *
+ * 受信したバイト列をそのまま値として読み出すため、検証は行いません。
+ */
+template <typename T>
+struct Codec<T, std::enable_if_t<std::is_trivially_copyable_v<T> &&
+                                 AnyBitPattern<T>::value>> {
+  static_assert(std::is_default_constructible_v<T>,
+                "T must be default constructible");
+
+  static constexpr bool is_fixed_size = true;
+  static constexpr std::size_t fixed_size = sizeof(T);
+
+  static constexpr std::size_t encoded_size(const T&) {
+    return sizeof(T);
+  }
+
+  static void encode(const T& value, std::byte* out) {
+    std::memcpy(out, &value, sizeof(T));
+  }
+
+  static Result<T, WireError> decode(const std::byte* data, std::size_t size,
+                                     std::size_t& consumed) {
+    if (size < sizeof(T)) {
+      return make_err(WireError::Truncated);
+    }
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    consumed = sizeof(T);
+    return make_ok(value);
+  }
+};
+
+/**
+ * @brief bool のCodec
+ *
+ * 1バイトの0または1を格納し、それ以外の値は InvalidPayload とします。
+ */
+template <>
+struct Codec<bool> {
+  static constexpr bool is_fixed_size = true;
+  static constexpr std::size_t fixed_size = 1;
+
+  static constexpr std::size_t encoded_size(bool) {
+    return 1;
+  }
+
+  static void encode(bool value, std::byte* out) {
+    out[0] = value ? std::byte{1} : std::byte{0};
+  }
+
+  static Result<bool, WireError> decode(const std::byte* data,
+                                        std::size_t size,
+                                        std::size_t& consumed) {
+    if (size < 1) {
+      return make_err(WireError::Truncated);
+    }
+    if (data[0] != std::byte{0} && data[0] != std::byte{1}) {
+      return make_err(WireError::InvalidPayload);
+    }
+    consumed = 1;
+    return make_ok(data[0] == std::byte{1});
+  }
+};
+
+/**
+ * @brief std::string のCodec
+ *
+ * 4バイトの長さに続けて文字列のバイト列を格納します。
+ * 長さが4バイトに収まらない文字列は InvalidPayload とします。
+ */
+template <>
+struct Codec<std::string> {
+  static constexpr bool is_fixed_size = false;
+
+  static std::size_t encoded_size(const std::string& value) {
+    return sizeof(std::uint32_t) + value.size();
+  }
+
+  static Result<void, WireError> encode(const std::string& value,
+                                        std::byte* out) {
+    if (value.size() > std::numeric_limits<std::uint32_t>::max()) {
+      return make_err(WireError::InvalidPayload);
+    }
+    auto length = static_cast<std::uint32_t>(value.size());
+    std::memcpy(out, &length, sizeof(length));
+    std::memcpy(out + sizeof(length), value.data(), value.size());
+    return make_ok();
+  }
+
+  static Result<std::string, WireError> decode(const std::byte* data,
+                                               std::size_t size,
+                                               std::size_t& consumed) {
+    std::uint32_t length = 0;
+    if (size < sizeof(length)) {
+      return make_err(WireError::Truncated);
+    }
+    std::memcpy(&length, data, sizeof(length));
+    if (size - sizeof(length) < length) {
+      return make_err(WireError::Truncated);
+    }
+    consumed = sizeof(length) + length;
+    return make_ok(std::string(
+        reinterpret_cast<const char*>(data + sizeof(length)), length));
+  }
+};
+
+namespace detail {
+
+template <typename T, typename E>
+struct WireTraits {
+  static constexpr bool is_fixed_size =
+      Codec<T>::is_fixed_size && Codec<E>::is_fixed_size;
+  static constexpr std::size_t max_payload_size() {
+    return Codec<T>::fixed_size > Codec<E>::fixed_size ? Codec<T>::fixed_size
+                                                       : Codec<E>::fixed_size;
+  }
+};
+
+template <typename E>
+struct WireTraits<void, E> {
+  static constexpr bool is_fixed_size = Codec<E>::is_fixed_size;
+  static constexpr std::size_t max_payload_size() {
+    return Codec<E>::fixed_size;
+  }
+};
+
+/**
+ * @brief Codec<T>::encode を呼び出し、戻り値を Result に揃える
+ *
+ * encode が void を返すCodecは常に成功として扱います。
+ */
+template <typename T>
+Result<void, WireError> encode_payload(const T& value, std::byte* out) {
+  if constexpr (std::is_void_v<decltype(Codec<T>::encode(value, out))>) {
+    Codec<T>::encode(value, out);
+    return make_ok();
+  } else {
+    return Codec<T>::encode(value, out);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief 固定長でエンコードされるResultの最大バイト数
+ * @tparam T 成功値の型
+ * @tparam E 失敗値の型
+ *
+ * 成功値・失敗値ともに固定長のCodecを持つ場合のみ使用できます。
+ * 共有メモリのスロットなど、固定長の領域を確保する場合に使用します。
+ */
+template <typename T, typename E>
+constexpr std::size_t max_encoded_size() {
+  static_assert(detail::WireTraits<T, E>::is_fixed_size,
+                "Codec of T and E must be fixed size");
+  return 1 + detail::WireTraits<T, E>::max_payload_size();
+}
+
+/**
+ * @brief Resultのエンコード後のバイト数を取得
+ * @param result 対象のResult
+ * @return std::size_t タグを含むバイト数
+ */
+template <typename T, typename E>
+std::size_t encoded_size(const Result<T, E>& result) {
+  return 1 + result.match(
+                 [](const T& value) { return Codec<T>::encoded_size(value); },
+                 [](const E& value) { return Codec<E>::encoded_size(value); });
+}
+
+/**
+ * @brief Result<void, E> のエンコード後のバイト数を取得
+ * @param result 対象のResult
+ * @return std::size_t タグを含むバイト数
+ */
+template <typename E>
+std::size_t encoded_size(const Result<void, E>& result) {
+  return 1 + result.match(
+                 []() { return std::size_t{0}; },
+                 [](const E& value) { return Codec<E>::encoded_size(value); });
+}
+
+/**
+ * @brief Resultをバイト列にエンコード
+ * @param result 対象のResult
+ * @param out 書き込み先
+ * @param capacity 書き込み先のバイト数
+ * @return Result<std::size_t, WireError> 書き込んだバイト数
+ *
+ * 先頭1バイトにタグ(WireTag)を、続けてペイロードを書き込みます。
+ * ペイロードをエンコードできない場合は何も書き込まずに
+ * InvalidPayload などのエラーを返します。
+ */
+template <typename T, typename E>
+Result<std::size_t, WireError> encode(const Result<T, E>& result,
+                                      std::byte* out, std::size_t capacity) {
+  std::size_t size = encoded_size(result);
+  if (capacity < size) {
+    return make_err(WireError::BufferTooSmall);
+  }
+  // ペイロードの検証に失敗した場合に何も書き込まないよう、タグは最後に書く
+  if (result.is_ok()) {
+    if constexpr (!std::is_void_v<T>) {
+      auto written = detail::encode_payload(result.unchecked_ok(), out + 1);
+      if (written.is_err()) {
+        return make_err(written.unwrap_err());
+      }
+    }
+    out[0] = static_cast<std::byte>(WireTag::Ok);
+  } else {
+    auto written = detail::encode_payload(result.unchecked_err(), out + 1);
+    if (written.is_err()) {
+      return make_err(written.unwrap_err());
+    }
+    out[0] = static_cast<std::byte>(WireTag::Err);
+  }
+  return make_ok(size);
+}
+
+/**
+ * @brief バイト列からResultをデコード
+ * @param data 読み込むバイト列
+ * @param size バイト列のバイト数
+ * @param consumed 読み込んだバイト数の格納先
+ * @return Result<Result<T, E>, WireError> デコードしたResult
+ */
+template <typename T, typename E>
+Result<Result<T, E>, WireError> decode(const std::byte* data, std::size_t size,
+                                       std::size_t& consumed) {
+  if (size < 1) {
+    return make_err(WireError::Truncated);
+  }
+  std::size_t payload_size = 0;
+  switch (static_cast<WireTag>(data[0])) {
+    case WireTag::Ok:
+      if constexpr (std::is_void_v<T>) {
+        consumed = 1;
+        return make_ok(Result<T, E>(make_ok()));
+      } else {
+        auto value = Codec<T>::decode(data + 1, size - 1, payload_size);
+        if (value.is_err()) {
+          return make_err(value.unwrap_err());
+        }
+        consumed = 1 + payload_size;
+        return make_ok(Result<T, E>(Ok<T>(value.unwrap())));
+      }
+    case WireTag::Err: {
+      auto value = Codec<E>::decode(data + 1, size - 1, payload_size);
+      if (value.is_err()) {
+        return make_err(value.unwrap_err());
+      }
+      consumed = 1 + payload_size;
+      return make_ok(Result<T, E>(Err<E>(value.unwrap())));
+    }
+  }
+  return make_err(WireError::InvalidTag);
+}
+
+/**
+ * @brief バイト列からResultをデコード
+ * @param data 読み込むバイト列
+ * @param size バイト列のバイト数
+ * @return Result<Result<T, E>, WireError> デコードしたResult
+ */
+template <typename T, typename E>
+Result<Result<T, E>, WireError> decode(const std::byte* data,
+                                       std::size_t size) {
+  std::size_t consumed = 0;
+  return decode<T, E>(data, size, consumed);
+}
+
+/**
+ * @brief エンコード済みのResultをデシリアライズせずに参照するビュー
+ * @tparam T 成功値の型
+ * @tparam E 失敗値の型
+ *
+ * バッファを所有せず、ペイロードはアクセス時にその場で読み出します。
+ * 参照先のバッファはビューより長く生存している必要があります。
+ */
+template <typename T, typename E>
+class ResultView final {
+ private:
+  const std::byte* m_data = nullptr;
+  std::size_t m_size = 0;
+
+  ResultView(const std::byte* data, std::size_t size)
+      : m_data(data), m_size(size) {}
+
+ public:
+  /**
+   * @brief バイト列からビューを生成
+   * @param data エンコード済みのバイト列
+   * @param size バイト列のバイト数
+   * @return Result<ResultView, WireError> 生成したビュー
+   *
+   * タグと、固定長のペイロードであればその長さを検証します。
+   */
+  static Result<ResultView, WireError> from_bytes(const std::byte* data,
+                                                  std::size_t size) {
+    if (size < 1) {
+      return make_err(WireError::Truncated);
+    }
+    std::size_t payload_size = 0;
+    switch (static_cast<WireTag>(data[0])) {
+      case WireTag::Ok:
+        if constexpr (std::is_void_v<T>) {
+          payload_size = 0;
+        } else if constexpr (Codec<T>::is_fixed_size) {
+          payload_size = Codec<T>::fixed_size;
+        }
+        break;
+      case WireTag::Err:
+        if constexpr (Codec<E>::is_fixed_size) {
+          payload_size = Codec<E>::fixed_size;
+        }
+        break;
+      default:
+        return make_err(WireError::InvalidTag);
+    }
+    if (size - 1 < payload_size) {
+      return make_err(WireError::Truncated);
+    }
+    return make_ok(ResultView(data, size));
+  }
+
+  /**
+   * @brief 成功値を保持しているか確認
+   * @return bool 成功値を保持している場合true
+   */
+  bool is_ok() const {
+    return m_data[0] == static_cast<std::byte>(WireTag::Ok);
+  }
+
+  /**
+   * @brief 失敗値を保持しているか確認
+   * @return bool 失敗値を保持している場合true
+   */
+  bool is_err() const {
+    return m_data[0] == static_cast<std::byte>(WireTag::Err);
+  }
+
+  /**
+   * @brief ペイロードの先頭を取得
+   * @return const std::byte* ペイロードの先頭
+   */
+  const std::byte* payload() const {
+    return m_data + 1;
+  }
+
+  /**
+   * @brief ペイロードとして参照可能なバイト数を取得
+   * @return std::size_t ペイロードのバイト数
+   */
+  std::size_t payload_size() const {
+    return m_size - 1;
+  }
+
+  /**
+   * @brief 成功値を読み出す
+   * @return Result<T, WireError> 読み出した成功値
+   * @note 失敗値を保持している場合はアサーション違反
+   */
+  template <typename U = T, std::enable_if_t<!std::is_void_v<U>, int> = 0>
+  Result<U, WireError> load_ok() const {
+    assert(is_ok());
+    std::size_t consumed = 0;
+    return Codec<U>::decode(payload(), payload_size(), consumed);
+  }
+
+  /**
+   * @brief 失敗値を読み出す
+   * @return Result<E, WireError> 読み出した失敗値
+   * @note 成功値を保持している場合はアサーション違反
+   */
+  Result<E, WireError> load_err() const {
+    assert(is_err());
+    std::size_t consumed = 0;
+    return Codec<E>::decode(payload(), payload_size(), consumed);
+  }
+};
+
+}  // namespace t9_result
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "result.h"
+
+namespace t9_result {
+
+namespace detail {
+
+template <bool Atomic>
+struct SharedErrorRefCount;
+
+template <>
+struct SharedErrorRefCount<true> {
+  std::atomic<std::uint32_t> m_count{1};
+
+  void increment() {
+    m_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // 0 になった場合true
+  bool decrement() {
+    return m_count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+
+  std::uint32_t load() const {
+    return m_count.load(std::memory_order_relaxed);
+  }
+};
+
+template <>
+struct SharedErrorRefCount<false> {
+  std::uint32_t m_count = 1;
+
+  void increment() {
+    ++m_count;
+  }
+
+  bool decrement() {
+    return --m_count == 0;
+  }
+
+  std::uint32_t load() const {
+    return m_count;
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief 参照カウントで共有する変更不可の失敗値
+ * @tparam Atomic 参照カウントをアトミックに操作する場合true
+ *
+ * 失敗値はエラーコードとメッセージを持ち、context() で原因となる
+ * 失敗値の前にメッセージを重ねた新しい失敗値を作れます。
+ * メッセージのノードは生成後に変更されないため、コピーはポインタと
+ * エラーコードのコピーと参照カウントの加算のみで、1つの失敗を
+ * 多数の待機中のリクエストへ配る場合も文字列は複製されません。
+ *
+ * ノードは1回の malloc でメッセージと一緒に確保します。
+ * 確保に失敗した場合はメッセージを持たない失敗値になります
+ * （エラーコードは保持します）。
+ *
+ * スレッド間で共有する場合は SharedError、単一スレッド内のみで
+ * 使用する場合は LocalSharedError を使用します。
+ *
+ * @code
+ * Result<Config, SharedError> load(const char* path) {
+ *   return read_file(path).map_err(with_context("loading config"));
+ * }
+ * @endcode
+ */
+template <bool Atomic>
+class BasicSharedError final {
+ private:
+  struct Node {
+    detail::SharedErrorRefCount<Atomic> m_refs;
+    Node* m_cause;
+    std::size_t m_length;
+    char m_message[1];  // 実際は m_length + 1 バイト
+  };
+
+  Node* m_node = nullptr;
+  int m_code = 0;
+
+  BasicSharedError(Node* node, int code) : m_node(node), m_code(code) {}
+
+  static Node* create(std::string_view message, Node* cause) {
+    void* memory =
+        std::malloc(offsetof(Node, m_message) + message.size() + 1);
+    if (!memory) {
+      return nullptr;
+    }
+    Node* node = new (memory) Node();
+    if (cause) {
+      cause->m_refs.increment();
+    }
+    node->m_cause = cause;
+    node->m_length = message.size();
+    std::memcpy(node->m_message, message.data(), message.size());
+    node->m_message[message.size()] = '\0';
+    return node;
+  }
+
+  // 原因の連鎖が長くても再帰しないよう、ループで解放する
+  static void release(Node* node) {
+    while (node && node->m_refs.decrement()) {
+      Node* cause = node->m_cause;
+      node->~Node();
+      std::free(node);
+      node = cause;
+    }
+  }
+
+ public:
+  /**
+   * @brief 失敗値を生成
+   * @param code エラーコード
+   * @param message メッセージ（複製して保持します）
+   * @return BasicSharedError 生成した失敗値
+   */
+  static BasicSharedError make(int code, std::string_view message) {
+    return BasicSharedError(create(message, nullptr), code);
+  }
+
+  BasicSharedError(const BasicSharedError& other)
+      : m_node(other.m_node), m_code(other.m_code) {
+    if (m_node) {
+      m_node->m_refs.increment();
+    }
+  }
+
+  BasicSharedError(BasicSharedError&& other)
+      : m_node(std::exchange(other.m_node, nullptr)), m_code(other.m_code) {}
+
+  BasicSharedError& operator=(const BasicSharedError& other) {
+    BasicSharedError(other).swap(*this);
+    return *this;
+  }
+
+  BasicSharedError& operator=(BasicSharedError&& other) {
+    BasicSharedError(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  ~BasicSharedError() {
+    release(m_node);
+  }
+
+  void swap(BasicSharedError& other) {
+    std::swap(m_node, other.m_node);
+    std::swap(m_code, other.m_code);
+  }
+
+  /**
+   * @brief 前にメッセージを重ねた失敗値を生成
+   * @param message 追加するメッセージ（複製して保持します）
+   * @return BasicSharedError この失敗値を原因とする失敗値
+   *
+   * エラーコードは引き継ぎます。この失敗値は変更されません。
+   */
+  BasicSharedError context(std::string_view message) const {
+    Node* node = create(message, m_node);
+    if (!node) {
+      // メッセージを追加できない場合は原因をそのまま返す
+      return *this;
+    }
+    return BasicSharedError(node, m_code);
+  }
+
+  /**
+   * @brief エラーコードを取得
+   * @return int エラーコード
+   */
+  int code() const {
+    return m_code;
+  }
+
+  /**
+   * @brief 最も外側のメッセージを取得
+   * @return std::string_view メッセージ（ない場合は空）
+   */
+  std::string_view message() const {
+    return m_node ? std::string_view(m_node->m_message, m_node->m_length)
+                  : std::string_view();
+  }
+
+  /**
+   * @brief 外側から順に各メッセージに関数を適用
+   * @tparam F std::string_view を受け取る関数の型
+   * @param f 適用する関数
+   */
+  template <typename F>
+  void for_each_message(F&& f) const {
+    for (const Node* node = m_node; node; node = node->m_cause) {
+      f(std::string_view(node->m_message, node->m_length));
+    }
+  }
+
+  /**
+   * @brief メッセージを外側から順に ": " で連結した文字列を取得
+   * @return std::string 連結した文字列
+   */
+  std::string to_string() const {
+    std::string text;
+    for_each_message([&text](std::string_view message) {
+      if (!text.empty()) {
+        text += ": ";
+      }
+      text += message;
+    });
+    return text;
+  }
+
+  /**
+   * @brief 最も外側のノードの参照数を取得（デバッグ用）
+   * @return std::uint32_t 参照数（メッセージがない場合は0）
+   */
+  std::uint32_t use_count() const {
+    return m_node ? m_node->m_refs.load() : 0;
+  }
+};
+
+/// スレッド間で共有できる失敗値
+using SharedError = BasicSharedError<true>;
+
+/// 単一スレッド内でのみ共有する失敗値
+using LocalSharedError = BasicSharedError<false>;
+
+/**
+ * @brief map_err() に渡してメッセージを重ねる関数オブジェクトを生成
+ * @param message 追加するメッセージ（呼び出し時まで有効であること）
+ * @return 失敗値を受け取り context(message) を返す関数オブジェクト
+ */
+inline auto with_context(std::string_view message) {
+  return [message](const auto& error) { return error.context(message); };
+}
+
+}  // namespace t9_result
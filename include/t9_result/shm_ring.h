@@ -0,0 +1,319 @@
+#pragma once
+
+#if !defined(__linux__)
+#error "shm_ring.h is only available on Linux"
+#endif
+
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "deadline.h"
+#include "result.h"
+#include "serialize.h"
+
+namespace t9_result {
+
+/**
+ * @brief 共有メモリ操作のシステムエラー
+ */
+struct ShmError {
+  const char* m_operation;  ///< 失敗したシステムコール名
+  int m_errno;              ///< errno の値
+};
+
+/**
+ * @brief リングバッファ操作のエラー
+ */
+enum class RingError {
+  Full,   ///< 空きスロットがない
+  Empty,  ///< 読み出せるスロットがない
+};
+
+namespace detail {
+
+inline void futex_wait(std::atomic<std::uint32_t>* word,
+                       std::uint32_t expected) {
+  ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAIT,
+            expected, nullptr, nullptr, 0);
+}
+
+// 期限を過ぎるか起こされるまで待機する
+inline void futex_wait_until(std::atomic<std::uint32_t>* word,
+                             std::uint32_t expected, Deadline deadline) {
+  if (deadline.is_never()) {
+    futex_wait(word, expected);
+    return;
+  }
+  // FUTEX_WAIT のタイムアウトは CLOCK_MONOTONIC 上の相対時間
+  auto remaining = deadline.remaining();
+  auto seconds = std::chrono::duration_cast<std::chrono::seconds>(remaining);
+  timespec timeout;
+  timeout.tv_sec = static_cast<time_t>(seconds.count());
+  timeout.tv_nsec = static_cast<long>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(remaining - seconds)
+          .count());
+  ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAIT,
+            expected, &timeout, nullptr, 0);
+}
+
+inline void futex_wake(std::atomic<std::uint32_t>* word) {
+  ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(word), FUTEX_WAKE, 1,
+            nullptr, nullptr, 0);
+}
+
+}  // namespace detail
+
+/**
+ * @brief プロセス間で Result を受け渡す共有メモリ上の SPSC リングバッファ
+ * @tparam T 成功値の型（トリビアルコピー可能で固定長のCodecを持つこと）
+ * @tparam E 失敗値の型（トリビアルコピー可能で固定長のCodecを持つこと）
+ * @tparam Capacity スロット数（2のべき乗）
+ *
+ * memfd 上に固定長のスロットを確保し、serialize.h の形式で Result を格納します。
+ * 生産者・消費者はそれぞれ1つのスレッド（プロセス）に限られます。
+ * 待機が必要な場合のみ futex でスリープするため、定常状態では
+ * システムコールを発行しません。
+ *
+ * 別プロセスとは fork による継承や SCM_RIGHTS で fd() を共有し、
+ * attach() でマッピングします。
+ */
+template <typename T, typename E, std::size_t Capacity>
+class ShmResultRing final {
+  static_assert(std::is_trivially_copyable_v<T> &&
+                    std::is_trivially_copyable_v<E>,
+                "T and E must be trivially copyable");
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+  static_assert(Capacity <= (std::size_t{1} << 31), "Capacity is too large");
+  static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+ public:
+  /// 1スロットのバイト数
+  static constexpr std::size_t kSlotSize = max_encoded_size<T, E>();
+
+ private:
+  struct Header {
+    alignas(64) std::atomic<std::uint32_t> m_head{0};  // 生産者が書き込む位置
+    std::atomic<std::uint32_t> m_consumer_waiting{0};
+    alignas(64) std::atomic<std::uint32_t> m_tail{0};  // 消費者が読み込む位置
+    std::atomic<std::uint32_t> m_producer_waiting{0};
+  };
+
+  static constexpr std::size_t kMappingSize =
+      sizeof(Header) + Capacity * kSlotSize;
+
+  int m_fd = -1;
+  void* m_mapping = nullptr;
+
+  ShmResultRing(int fd, void* mapping) : m_fd(fd), m_mapping(mapping) {}
+
+  Header& header() const {
+    return *static_cast<Header*>(m_mapping);
+  }
+
+  std::byte* slot(std::uint32_t index) const {
+    return static_cast<std::byte*>(m_mapping) + sizeof(Header) +
+           (index & (Capacity - 1)) * kSlotSize;
+  }
+
+  static Result<void*, ShmError> map(int fd) {
+    void* mapping = ::mmap(nullptr, kMappingSize, PROT_READ | PROT_WRITE,
+                           MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+      return make_err(ShmError{"mmap", errno});
+    }
+    return make_ok(mapping);
+  }
+
+ public:
+  /**
+   * @brief 共有メモリを新たに確保してリングバッファを生成
+   * @return Result<ShmResultRing, ShmError> 生成したリングバッファ
+   */
+  static Result<ShmResultRing, ShmError> create() {
+    int fd = ::memfd_create("t9_result_ring", MFD_CLOEXEC);
+    if (fd < 0) {
+      return make_err(ShmError{"memfd_create", errno});
+    }
+    if (::ftruncate(fd, kMappingSize) != 0) {
+      ShmError error{"ftruncate", errno};
+      ::close(fd);
+      return make_err(error);
+    }
+    auto mapping = map(fd);
+    if (mapping.is_err()) {
+      ::close(fd);
+      return make_err(mapping.unwrap_err());
+    }
+    new (mapping.ref_ok()) Header();
+    return make_ok(ShmResultRing(fd, mapping.unwrap()));
+  }
+
+  /**
+   * @brief 既存の共有メモリにリングバッファとして接続
+   * @param fd create() で生成したリングバッファの fd()（複製したもの）
+   * @return Result<ShmResultRing, ShmError> 接続したリングバッファ
+   *
+   * 成功した場合、fd の所有権はリングバッファに移ります。
+   */
+  static Result<ShmResultRing, ShmError> attach(int fd) {
+    auto mapping = map(fd);
+    if (mapping.is_err()) {
+      return make_err(mapping.unwrap_err());
+    }
+    return make_ok(ShmResultRing(fd, mapping.unwrap()));
+  }
+
+  ShmResultRing(const ShmResultRing&) = delete;
+  ShmResultRing& operator=(const ShmResultRing&) = delete;
+
+  ShmResultRing(ShmResultRing&& other)
+      : m_fd(std::exchange(other.m_fd, -1)),
+        m_mapping(std::exchange(other.m_mapping, nullptr)) {}
+
+  ShmResultRing& operator=(ShmResultRing&& other) {
+    ShmResultRing(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  ~ShmResultRing() {
+    if (m_mapping) {
+      ::munmap(m_mapping, kMappingSize);
+    }
+    if (m_fd >= 0) {
+      ::close(m_fd);
+    }
+  }
+
+  void swap(ShmResultRing& other) {
+    std::swap(m_fd, other.m_fd);
+    std::swap(m_mapping, other.m_mapping);
+  }
+
+  /**
+   * @brief 共有メモリのファイルディスクリプタを取得
+   * @return int ファイルディスクリプタ
+   */
+  int fd() const {
+    return m_fd;
+  }
+
+  /**
+   * @brief Resultを書き込む（待機しない）
+   * @param result 書き込むResult（Codec がエンコードできる値であること）
+   * @return Result<void, RingError> 満杯の場合は RingError::Full
+   */
+  Result<void, RingError> try_push(const Result<T, E>& result) {
+    Header& h = header();
+    std::uint32_t head = h.m_head.load(std::memory_order_relaxed);
+    std::uint32_t tail = h.m_tail.load(std::memory_order_acquire);
+    if (head - tail == Capacity) {
+      return make_err(RingError::Full);
+    }
+    [[maybe_unused]] auto written = encode(result, slot(head), kSlotSize);
+    // スロットは最大長で確保しているため、失敗するのは Codec が値を拒否した場合のみ
+    assert(written.is_ok());
+    h.m_head.store(head + 1, std::memory_order_seq_cst);
+    if (h.m_consumer_waiting.load(std::memory_order_seq_cst) &&
+        h.m_consumer_waiting.exchange(0, std::memory_order_seq_cst)) {
+      detail::futex_wake(&h.m_head);
+    }
+    return make_ok();
+  }
+
+  /**
+   * @brief Resultを書き込む（空きができるまで待機する）
+   * @param result 書き込むResult
+   */
+  void push(const Result<T, E>& result) {
+    Header& h = header();
+    while (try_push(result).is_err()) {
+      std::uint32_t tail = h.m_tail.load(std::memory_order_seq_cst);
+      h.m_producer_waiting.store(1, std::memory_order_seq_cst);
+      if (h.m_head.load(std::memory_order_relaxed) - tail == Capacity &&
+          h.m_tail.load(std::memory_order_seq_cst) == tail) {
+        detail::futex_wait(&h.m_tail, tail);
+      }
+    }
+  }
+
+  /**
+   * @brief Resultを読み出す（待機しない）
+   * @return Result<Result<T, E>, RingError> 空の場合は RingError::Empty
+   */
+  Result<Result<T, E>, RingError> try_pop() {
+    Header& h = header();
+    std::uint32_t tail = h.m_tail.load(std::memory_order_relaxed);
+    std::uint32_t head = h.m_head.load(std::memory_order_acquire);
+    if (head == tail) {
+      return make_err(RingError::Empty);
+    }
+    // 生産者が検証済みの形式で書き込んでいるため、デコードは失敗しない
+    auto decoded = decode<T, E>(slot(tail), kSlotSize);
+    h.m_tail.store(tail + 1, std::memory_order_seq_cst);
+    if (h.m_producer_waiting.load(std::memory_order_seq_cst) &&
+        h.m_producer_waiting.exchange(0, std::memory_order_seq_cst)) {
+      detail::futex_wake(&h.m_tail);
+    }
+    return make_ok(decoded.unwrap());
+  }
+
+  /**
+   * @brief Resultを読み出す（書き込まれるまで待機する）
+   * @return Result<T, E> 読み出したResult
+   */
+  Result<T, E> pop() {
+    Header& h = header();
+    for (;;) {
+      auto popped = try_pop();
+      if (popped.is_ok()) {
+        return popped.unwrap();
+      }
+      std::uint32_t head = h.m_head.load(std::memory_order_seq_cst);
+      h.m_consumer_waiting.store(1, std::memory_order_seq_cst);
+      if (h.m_tail.load(std::memory_order_relaxed) == head &&
+          h.m_head.load(std::memory_order_seq_cst) == head) {
+        detail::futex_wait(&h.m_head, head);
+      }
+    }
+  }
+
+  /**
+   * @brief Resultを読み出す（書き込まれるか期限を過ぎるまで待機する）
+   * @param deadline 期限
+   * @return Result<Result<T, E>, Timeout> 期限を過ぎた場合は Timeout
+   */
+  Result<Result<T, E>, Timeout> pop(Deadline deadline) {
+    Header& h = header();
+    for (;;) {
+      auto popped = try_pop();
+      if (popped.is_ok()) {
+        return make_ok(popped.unwrap());
+      }
+      if (deadline.expired()) {
+        return make_err(Timeout{});
+      }
+      std::uint32_t head = h.m_head.load(std::memory_order_seq_cst);
+      h.m_consumer_waiting.store(1, std::memory_order_seq_cst);
+      if (h.m_tail.load(std::memory_order_relaxed) == head &&
+          h.m_head.load(std::memory_order_seq_cst) == head) {
+        detail::futex_wait_until(&h.m_head, head, deadline);
+      }
+    }
+  }
+};
+
+}  // namespace t9_result
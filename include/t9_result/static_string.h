@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+#include "result.h"
+#include "static_vector.h"
+
+namespace t9_result {
+
+/**
+ * @brief ヒープを使用しない固定容量の文字列
+ * @tparam N 容量（終端のヌル文字を除く）
+ *
+ * 文字列の追加は容量を超える場合に CapacityError を返し、
+ * 文字列は変更されません。
+ */
+template <std::size_t N>
+class StaticString final {
+ private:
+  char m_data[N + 1] = {};
+  std::size_t m_size = 0;
+
+ public:
+  StaticString() = default;
+
+  /**
+   * @brief 文字列から生成
+   * @param text 初期値
+   * @return Result<StaticString, CapacityError> 生成した文字列
+   */
+  static Result<StaticString, CapacityError> from(std::string_view text) {
+    StaticString s;
+    auto appended = s.try_append(text);
+    if (appended.is_err()) {
+      return make_err(appended.unwrap_err());
+    }
+    return make_ok(s);
+  }
+
+  /**
+   * @brief 末尾に文字列を追加
+   * @param text 追加する文字列
+   * @return Result<void, CapacityError> 容量を超える場合は失敗
+   */
+  Result<void, CapacityError> try_append(std::string_view text) {
+    if (text.size() > N - m_size) {
+      return make_err(CapacityError{N, m_size + text.size()});
+    }
+    std::memcpy(m_data + m_size, text.data(), text.size());
+    m_size += text.size();
+    m_data[m_size] = '\0';
+    return make_ok();
+  }
+
+  /**
+   * @brief 末尾に1文字追加
+   * @param c 追加する文字
+   * @return Result<void, CapacityError> 容量を超える場合は失敗
+   */
+  Result<void, CapacityError> try_push_back(char c) {
+    if (m_size == N) {
+      return make_err(CapacityError{N, m_size + 1});
+    }
+    m_data[m_size++] = c;
+    m_data[m_size] = '\0';
+    return make_ok();
+  }
+
+  /**
+   * @brief 内容を空にする
+   */
+  void clear() {
+    m_size = 0;
+    m_data[0] = '\0';
+  }
+
+  const char* c_str() const {
+    return m_data;
+  }
+
+  std::string_view view() const {
+    return std::string_view(m_data, m_size);
+  }
+
+  std::size_t size() const {
+    return m_size;
+  }
+
+  bool empty() const {
+    return m_size == 0;
+  }
+
+  static constexpr std::size_t capacity() {
+    return N;
+  }
+};
+
+}  // namespace t9_result
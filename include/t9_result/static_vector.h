@@ -0,0 +1,214 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "result.h"
+
+namespace t9_result {
+
+/**
+ * @brief 固定容量のコンテナに要素を追加できなかったことを表すエラー
+ */
+struct CapacityError {
+  std::size_t m_capacity;   ///< コンテナの容量
+  std::size_t m_requested;  ///< 追加後に必要となる要素数
+};
+
+/**
+ * @brief ヒープを使用しない固定容量の可変長配列
+ * @tparam T 要素の型
+ * @tparam N 容量
+ *
+ * 要素の追加は容量を超える場合に CapacityError を返し、abort しません。
+ * 追加した要素への参照は Result<T&, CapacityError> として返します。
+ */
+template <typename T, std::size_t N>
+class StaticVector final {
+ private:
+  alignas(T) std::byte m_storage[N == 0 ? 1 : N * sizeof(T)];
+  std::size_t m_size = 0;
+
+  T* ptr(std::size_t index) {
+    return std::launder(reinterpret_cast<T*>(m_storage)) + index;
+  }
+
+  const T* ptr(std::size_t index) const {
+    return std::launder(reinterpret_cast<const T*>(m_storage)) + index;
+  }
+
+ public:
+  StaticVector() = default;
+
+  StaticVector(const StaticVector& other) {
+    for (const T& value : other) {
+      new (ptr(m_size)) T(value);
+      ++m_size;
+    }
+  }
+
+  StaticVector(StaticVector&& other) {
+    for (T& value : other) {
+      new (ptr(m_size)) T(std::move(value));
+      ++m_size;
+    }
+  }
+
+  StaticVector& operator=(const StaticVector& other) {
+    if (this != &other) {
+      clear();
+      for (const T& value : other) {
+        new (ptr(m_size)) T(value);
+        ++m_size;
+      }
+    }
+    return *this;
+  }
+
+  StaticVector& operator=(StaticVector&& other) {
+    if (this != &other) {
+      clear();
+      for (T& value : other) {
+        new (ptr(m_size)) T(std::move(value));
+        ++m_size;
+      }
+    }
+    return *this;
+  }
+
+  ~StaticVector() {
+    clear();
+  }
+
+  /**
+   * @brief 末尾に要素を直接構築
+   * @tparam Args コンストラクタ引数の型
+   * @param args コンストラクタに渡す引数
+   * @return Result<T&, CapacityError> 構築した要素への参照
+   */
+  template <typename... Args>
+  Result<T&, CapacityError> try_emplace_back(Args&&... args) {
+    if (m_size == N) {
+      return make_err(CapacityError{N, m_size + 1});
+    }
+    T* p = new (ptr(m_size)) T(std::forward<Args>(args)...);
+    ++m_size;
+    return make_ok_ref(*p);
+  }
+
+  /**
+   * @brief 末尾に要素をコピー
+   * @param value 追加する値
+   * @return Result<T&, CapacityError> 追加した要素への参照
+   */
+  Result<T&, CapacityError> try_push_back(const T& value) {
+    return try_emplace_back(value);
+  }
+
+  /**
+   * @brief 末尾に要素をムーブ
+   * @param value 追加する値
+   * @return Result<T&, CapacityError> 追加した要素への参照
+   */
+  Result<T&, CapacityError> try_push_back(T&& value) {
+    return try_emplace_back(std::move(value));
+  }
+
+  /**
+   * @brief 指定位置に要素を挿入
+   * @param index 挿入位置（size() 以下）
+   * @param value 挿入する値
+   * @return Result<T&, CapacityError> 挿入した要素への参照
+   *
+   * 後続の要素は1つずつ後ろへムーブされます。
+   */
+  Result<T&, CapacityError> try_insert(std::size_t index, T value) {
+    assert(index <= m_size);
+    if (m_size == N) {
+      return make_err(CapacityError{N, m_size + 1});
+    }
+    if (index == m_size) {
+      return try_emplace_back(std::move(value));
+    }
+    new (ptr(m_size)) T(std::move(*ptr(m_size - 1)));
+    for (std::size_t i = m_size - 1; i > index; --i) {
+      *ptr(i) = std::move(*ptr(i - 1));
+    }
+    *ptr(index) = std::move(value);
+    ++m_size;
+    return make_ok_ref(*ptr(index));
+  }
+
+  /**
+   * @brief 末尾の要素を削除
+   * @note 空の場合はアサーション違反
+   */
+  void pop_back() {
+    assert(m_size > 0);
+    --m_size;
+    ptr(m_size)->~T();
+  }
+
+  /**
+   * @brief すべての要素を削除
+   */
+  void clear() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (std::size_t i = 0; i < m_size; ++i) {
+        ptr(i)->~T();
+      }
+    }
+    m_size = 0;
+  }
+
+  T& operator[](std::size_t index) {
+    assert(index < m_size);
+    return *ptr(index);
+  }
+
+  const T& operator[](std::size_t index) const {
+    assert(index < m_size);
+    return *ptr(index);
+  }
+
+  T* data() {
+    return ptr(0);
+  }
+
+  const T* data() const {
+    return ptr(0);
+  }
+
+  T* begin() {
+    return ptr(0);
+  }
+
+  T* end() {
+    return ptr(m_size);
+  }
+
+  const T* begin() const {
+    return ptr(0);
+  }
+
+  const T* end() const {
+    return ptr(m_size);
+  }
+
+  std::size_t size() const {
+    return m_size;
+  }
+
+  bool empty() const {
+    return m_size == 0;
+  }
+
+  static constexpr std::size_t capacity() {
+    return N;
+  }
+};
+
+}  // namespace t9_result
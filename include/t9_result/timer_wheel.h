@@ -0,0 +1,438 @@
+#pragma once
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "deadline.h"
+#include "function.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace t9_result {
+
+/**
+ * @brief TimerWheel に登録したタイマーの識別子
+ *
+ * 発火やキャンセルの後は無効になり、同じ位置が再利用されても
+ * 世代番号が異なるため別のタイマーを誤ってキャンセルしません。
+ */
+struct TimerId {
+  std::uint32_t m_index = 0;
+  std::uint32_t m_generation = 0;  ///< 0 は無効な識別子
+};
+
+/**
+ * @brief 階層型タイマーホイール
+ *
+ * 時刻を resolution 単位のティックで管理し、64スロットの階層を
+ * 11段重ねて64ビットのティックすべてを表します。タイマーは現在の
+ * ティックと最初に異なる6ビットの段に置かれ、その段の境界に達した時点で
+ * 下の段へ移されます。登録とキャンセルはタイマー数に依存しない O(1)、
+ * 発火は1タイマーあたり段の数以下の移動で行います。
+ * 段ごとに空でないスロットのビットマップを持つため、長い空白を
+ * 進める場合もティックごとの走査は行いません。
+ *
+ * スレッドセーフではありません。1つのスレッドから poll() を呼び出し、
+ * 期限付きの待機の期限を next_deadline() で決めるイベントループでの
+ * 使用を想定しています。コールバックの中から schedule() や cancel() を
+ * 呼び出せます。
+ *
+ * @code
+ * TimerWheel wheel(std::chrono::milliseconds(1));
+ * TimerId id = wheel.schedule(Deadline::after(std::chrono::seconds(5)),
+ *                             [&] { request.set(make_err(Timeout{})); });
+ * ...
+ * wheel.cancel(id);  // 期限前に完了した場合
+ * @endcode
+ */
+class TimerWheel final {
+ public:
+  using Clock = Deadline::Clock;
+  using Callback = UniqueFunction<void()>;
+
+  /// 段ごとのスロット数のビット数
+  static constexpr unsigned kSlotBits = 6;
+  static constexpr unsigned kSlots = 1u << kSlotBits;
+  /// 64ビットのティックを表すのに必要な段数
+  static constexpr unsigned kLevels = (64 + kSlotBits - 1) / kSlotBits;
+
+ private:
+  static constexpr std::uint32_t kNil =
+      std::numeric_limits<std::uint32_t>::max();
+  // 発火待ちの一時的なリスト
+  static constexpr std::uint16_t kFiring = kLevels * kSlots;
+  // 空きリストにあるノード
+  static constexpr std::uint16_t kFree = kFiring + 1;
+  static constexpr std::uint64_t kMaxTick =
+      std::numeric_limits<std::uint64_t>::max() - 1;
+
+  // 段の移動で走査する部分のみを持ち、コールバックは別の配列に置く
+  struct Node {
+    std::uint64_t m_expiry;
+    std::uint32_t m_prev;
+    std::uint32_t m_next;
+    std::uint32_t m_generation;
+    std::uint16_t m_slot;
+  };
+
+  std::vector<Node> m_nodes;
+  std::vector<Callback> m_callbacks;
+  std::uint32_t m_free = kNil;
+  std::size_t m_size = 0;
+  // 未処理の最も古いティック
+  std::uint64_t m_now = 0;
+  Clock::time_point m_start;
+  Clock::duration m_resolution;
+  std::uint64_t m_occupied[kLevels] = {};
+  std::uint32_t m_heads[kFiring + 1];
+
+  static unsigned slot_index(std::uint64_t tick, unsigned level) {
+    return static_cast<unsigned>(tick >> (level * kSlotBits)) & (kSlots - 1);
+  }
+
+  // 最下位の1のビット位置（bits != 0）
+  static unsigned lowest_bit(std::uint64_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward64(&index, bits);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+  }
+
+  // 最上位の1のビット位置（bits != 0）
+  static unsigned highest_bit(std::uint64_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanReverse64(&index, bits);
+    return static_cast<unsigned>(index);
+#else
+    return 63 - static_cast<unsigned>(__builtin_clzll(bits));
+#endif
+  }
+
+  static void prefetch(const void* address) {
+#if defined(_MSC_VER)
+#if defined(_M_X64) || defined(_M_IX86)
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+#else
+    __builtin_prefetch(address);
+#endif
+  }
+
+  void link(std::uint32_t index, std::uint16_t slot) {
+    Node& node = m_nodes[index];
+    node.m_slot = slot;
+    node.m_prev = kNil;
+    node.m_next = m_heads[slot];
+    if (node.m_next != kNil) {
+      m_nodes[node.m_next].m_prev = index;
+    }
+    m_heads[slot] = index;
+    if (slot < kFiring) {
+      m_occupied[slot / kSlots] |= std::uint64_t{1} << (slot % kSlots);
+    }
+  }
+
+  void unlink(std::uint32_t index) {
+    Node& node = m_nodes[index];
+    if (node.m_prev != kNil) {
+      m_nodes[node.m_prev].m_next = node.m_next;
+    } else {
+      m_heads[node.m_slot] = node.m_next;
+      if (node.m_slot == kFiring) {
+        // 発火待ちのリストは先頭のノードのみ m_slot を更新している
+        if (node.m_next != kNil) {
+          m_nodes[node.m_next].m_slot = kFiring;
+        }
+      } else if (node.m_next == kNil) {
+        m_occupied[node.m_slot / kSlots] &=
+            ~(std::uint64_t{1} << (node.m_slot % kSlots));
+      }
+    }
+    if (node.m_next != kNil) {
+      m_nodes[node.m_next].m_prev = node.m_prev;
+    }
+  }
+
+  // 現在のティックと最初に異なる段に置く
+  void place(std::uint32_t index) {
+    std::uint64_t expiry = m_nodes[index].m_expiry;
+    std::uint64_t diff = expiry ^ m_now;
+    unsigned level = diff == 0 ? 0 : highest_bit(diff) / kSlotBits;
+    link(index, static_cast<std::uint16_t>(level * kSlots +
+                                           slot_index(expiry, level)));
+  }
+
+  void release(std::uint32_t index) {
+    Node& node = m_nodes[index];
+    ++node.m_generation;
+    if (node.m_generation == 0) {
+      node.m_generation = 1;
+    }
+    node.m_slot = kFree;
+    node.m_next = m_free;
+    m_free = index;
+    --m_size;
+  }
+
+  // 上の段の境界に達したスロットのタイマーを下の段へ移す
+  void cascade(unsigned level) {
+    auto slot =
+        static_cast<std::uint16_t>(level * kSlots + slot_index(m_now, level));
+    std::uint32_t index = m_heads[slot];
+    m_heads[slot] = kNil;
+    m_occupied[level] &= ~(std::uint64_t{1} << (slot % kSlots));
+    while (index != kNil) {
+      std::uint32_t next = m_nodes[index].m_next;
+      if (next != kNil) {
+        prefetch(&m_nodes[next]);
+      }
+      place(index);
+      index = next;
+    }
+  }
+
+  // タイマーの発火か段の移動が必要な最初のティック
+  // 下の段の候補は上の段の候補より必ず前にある
+  bool next_event(std::uint64_t* tick) const {
+    for (unsigned level = 0; level < kLevels; ++level) {
+      std::uint64_t pending = m_occupied[level] &
+                              (~std::uint64_t{0} << slot_index(m_now, level));
+      if (pending == 0) {
+        continue;
+      }
+      unsigned shift = level * kSlotBits;
+      unsigned upper_shift = shift + kSlotBits;
+      std::uint64_t upper =
+          upper_shift >= 64 ? 0 : m_now >> upper_shift << upper_shift;
+      *tick = upper | (std::uint64_t{lowest_bit(pending)} << shift);
+      assert(*tick >= m_now);
+      return true;
+    }
+    return false;
+  }
+
+ public:
+  /**
+   * @brief タイマーホイールを生成
+   * @param resolution 1ティックの長さ
+   * @param start ティック0の時刻
+   */
+  explicit TimerWheel(
+      Clock::duration resolution = std::chrono::milliseconds(1),
+      Clock::time_point start = Clock::now())
+      : m_start(start), m_resolution(resolution) {
+    assert(resolution > Clock::duration::zero());
+    for (auto& head : m_heads) {
+      head = kNil;
+    }
+  }
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  /**
+   * @brief 指定した数のタイマーを再確保なしで登録できるようにする
+   * @param capacity タイマー数
+   */
+  void reserve(std::size_t capacity) {
+    m_nodes.reserve(capacity);
+    m_callbacks.reserve(capacity);
+  }
+
+  /**
+   * @brief 期限をティックに変換（切り上げ）
+   * @param deadline 期限
+   * @return std::uint64_t ティック
+   */
+  std::uint64_t tick_of(Deadline deadline) const {
+    if (deadline.is_never()) {
+      return kMaxTick;
+    }
+    if (deadline.time() <= m_start) {
+      return 0;
+    }
+    auto elapsed = deadline.time() - m_start;
+    auto ticks = static_cast<std::uint64_t>(elapsed / m_resolution) +
+                 (elapsed % m_resolution != Clock::duration::zero());
+    return ticks < kMaxTick ? ticks : kMaxTick;
+  }
+
+  /**
+   * @brief 時刻をティックに変換（切り捨て）
+   * @param time 時刻
+   * @return std::uint64_t ティック
+   */
+  std::uint64_t tick_at(Clock::time_point time) const {
+    if (time <= m_start) {
+      return 0;
+    }
+    auto ticks = static_cast<std::uint64_t>((time - m_start) / m_resolution);
+    return ticks < kMaxTick ? ticks : kMaxTick;
+  }
+
+  /**
+   * @brief 期限にコールバックを登録
+   * @param deadline 期限（過ぎている場合は次の poll() で発火します）
+   * @param callback 期限に呼び出す関数
+   * @return TimerId キャンセルに使用する識別子
+   */
+  TimerId schedule(Deadline deadline, Callback callback) {
+    return schedule_at(tick_of(deadline), std::move(callback));
+  }
+
+  /**
+   * @brief ティックを指定してコールバックを登録
+   * @param tick 発火するティック（処理済みの場合は次に処理するティック）
+   * @param callback 発火時に呼び出す関数
+   * @return TimerId キャンセルに使用する識別子
+   */
+  TimerId schedule_at(std::uint64_t tick, Callback callback) {
+    std::uint32_t index;
+    if (m_free != kNil) {
+      index = m_free;
+      m_free = m_nodes[index].m_next;
+      m_callbacks[index] = std::move(callback);
+    } else {
+      assert(m_nodes.size() < kNil);
+      index = static_cast<std::uint32_t>(m_nodes.size());
+      m_nodes.push_back(Node{0, kNil, kNil, 1, kFree});
+      m_callbacks.push_back(std::move(callback));
+    }
+    Node& node = m_nodes[index];
+    node.m_expiry = tick > m_now ? (tick < kMaxTick ? tick : kMaxTick) : m_now;
+    place(index);
+    ++m_size;
+    return TimerId{index, node.m_generation};
+  }
+
+  /**
+   * @brief 登録したタイマーを取り消す
+   * @param id schedule() で取得した識別子
+   * @return bool 取り消した場合true（発火済み、取り消し済みの場合false）
+   */
+  bool cancel(TimerId id) {
+    if (id.m_index >= m_nodes.size()) {
+      return false;
+    }
+    Node& node = m_nodes[id.m_index];
+    if (node.m_generation != id.m_generation || node.m_slot == kFree) {
+      return false;
+    }
+    unlink(id.m_index);
+    m_callbacks[id.m_index] = Callback();
+    release(id.m_index);
+    return true;
+  }
+
+  /**
+   * @brief 指定したティックまでに期限を迎えたタイマーを発火
+   * @param tick 処理する最後のティック
+   * @return std::size_t 発火したタイマーの数
+   */
+  std::size_t advance_to(std::uint64_t tick) {
+    if (tick > kMaxTick) {
+      tick = kMaxTick;
+    }
+    std::size_t fired = 0;
+    std::uint64_t event;
+    while (next_event(&event) && event <= tick) {
+      m_now = event;
+      for (unsigned level = kLevels - 1; level > 0; --level) {
+        std::uint64_t mask = (std::uint64_t{1} << (level * kSlotBits)) - 1;
+        std::uint64_t bit = std::uint64_t{1} << slot_index(m_now, level);
+        if ((m_now & mask) == 0 && (m_occupied[level] & bit) != 0) {
+          cascade(level);
+        }
+      }
+      auto slot = static_cast<std::uint16_t>(slot_index(m_now, 0));
+      if (m_heads[slot] == kNil) {
+        continue;
+      }
+      // コールバックで登録されたタイマーが同じスロットに入らないよう、
+      // 先にリストを切り離してティックを進める
+      std::uint32_t index = m_heads[slot];
+      m_heads[slot] = kNil;
+      m_occupied[0] &= ~(std::uint64_t{1} << slot);
+      m_heads[kFiring] = index;
+      m_nodes[index].m_slot = kFiring;
+      ++m_now;
+      while (m_heads[kFiring] != kNil) {
+        index = m_heads[kFiring];
+        unlink(index);
+        // 次のノードとコールバックの読み込みを呼び出しと重ねる
+        std::uint32_t next = m_heads[kFiring];
+        if (next != kNil) {
+          prefetch(&m_callbacks[next]);
+        }
+        // コールバック中の登録で配列が再確保されてもよいよう移動する
+        Callback callback = std::move(m_callbacks[index]);
+        release(index);
+        callback();
+        ++fired;
+      }
+    }
+    if (tick >= m_now) {
+      m_now = tick + 1;
+    }
+    return fired;
+  }
+
+  /**
+   * @brief 現在時刻までに期限を迎えたタイマーを発火
+   * @param now 現在時刻
+   * @return std::size_t 発火したタイマーの数
+   */
+  std::size_t poll(Clock::time_point now = Clock::now()) {
+    return advance_to(tick_at(now));
+  }
+
+  /**
+   * @brief 次に poll() を呼び出す必要がある時刻を取得
+   * @return Deadline 次のタイマーの期限以前の時刻（タイマーがない場合は期限なし）
+   *
+   * 上の段にあるタイマーは、段を移す境界の時刻を返します。
+   */
+  Deadline next_deadline() const {
+    std::uint64_t event;
+    if (!next_event(&event)) {
+      return Deadline::never();
+    }
+    if (event >= static_cast<std::uint64_t>(
+                     (Clock::time_point::max() - m_start) / m_resolution)) {
+      return Deadline::never();
+    }
+    return Deadline(m_start +
+                    m_resolution * static_cast<Clock::rep>(event));
+  }
+
+  /**
+   * @brief 次に処理するティックを取得
+   * @return std::uint64_t これより前のティックは処理済み
+   */
+  std::uint64_t current_tick() const {
+    return m_now;
+  }
+
+  std::size_t size() const {
+    return m_size;
+  }
+
+  bool empty() const {
+    return m_size == 0;
+  }
+};
+
+}  // namespace t9_result
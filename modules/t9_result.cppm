@@ -0,0 +1,21 @@
+// t9_result の C++20 名前付きモジュール
+// prelude.h と同じ API をエクスポートする（マクロはエクスポートされない）
+module;
+
+#include <t9_result/prelude.h>
+
+export module t9_result;
+
+export namespace t9_result {
+
+using t9_result::Err;
+using t9_result::Ok;
+using t9_result::Result;
+
+using t9_result::make_err;
+using t9_result::make_err_with;
+using t9_result::make_ok;
+using t9_result::make_ok_ref;
+using t9_result::make_ok_with;
+
+}  // namespace t9_result
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <t9_result/alloc.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace {
+
+using namespace t9_result;
+
+struct Point {
+  int x;
+  int y;
+};
+
+struct alignas(64) Aligned {
+  int value;
+};
+
+// try_new と try_make_unique の動作をテスト
+TEST(AllocTest, TryNew) {
+  {
+    auto p = try_new<Point>(Point{1, 2});
+    ASSERT_TRUE(p.is_ok());
+    EXPECT_EQ(p.ref_ok()->y, 2);
+    delete p.unwrap();
+  }
+  {
+    auto p = try_make_unique<Point>(Point{3, 4});
+    ASSERT_TRUE(p.is_ok());
+    EXPECT_EQ(p.unwrap()->x, 3);
+  }
+}
+
+// try_allocate の動作とサイズのオーバーフローをテスト
+TEST(AllocTest, TryAllocate) {
+  {
+    auto p = try_allocate<Aligned>(4);
+    ASSERT_TRUE(p.is_ok());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p.ref_ok()) % 64, 0u);
+    deallocate(p.unwrap());
+  }
+  {
+    auto p = try_allocate<Point>(std::numeric_limits<std::size_t>::max());
+    EXPECT_EQ(p.unwrap_err(), AllocError::SizeOverflow);
+  }
+}
+
+// アリーナからの切り出しとアラインメントをテスト
+TEST(AllocTest, Arena) {
+  auto arena = Arena::create(256).unwrap();
+  EXPECT_EQ(arena.capacity(), 256u);
+
+  auto a = arena.allocate(3, 1).unwrap();
+  EXPECT_EQ(a.size(), 3u);
+  auto b = arena.allocate(8, 8).unwrap();
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b.data()) % 8, 0u);
+  EXPECT_GE(b.data(), a.data() + 3);
+
+  auto point = arena.construct<Point>(Point{5, 6}).unwrap();
+  EXPECT_EQ(point->x, 5);
+  EXPECT_EQ(point->y, 6);
+}
+
+// アリーナの領域不足とリセットをテスト
+TEST(AllocTest, ArenaExhausted) {
+  alignas(16) std::byte buffer[64];
+  Arena arena(buffer, sizeof(buffer));
+
+  EXPECT_TRUE(arena.allocate(48, 16).is_ok());
+  EXPECT_EQ(arena.allocate(32, 16).unwrap_err(), AllocError::OutOfMemory);
+  EXPECT_EQ(arena.allocate(std::numeric_limits<std::size_t>::max(), 1)
+                .unwrap_err(),
+            AllocError::OutOfMemory);
+  EXPECT_EQ(arena.used(), 48u);
+
+  arena.reset();
+  EXPECT_EQ(arena.used(), 0u);
+  EXPECT_TRUE(arena.allocate(64, 16).is_ok());
+}
+
+}  // namespace
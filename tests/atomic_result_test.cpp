@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <t9_result/atomic_result.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+enum class Health : std::uint8_t {
+  Degraded = 1,
+  Down = 2,
+};
+
+// 8バイトに収まる場合の読み書きをテスト
+TEST(AtomicResultTest, LockFree) {
+  using Status = Result<std::uint32_t, Health>;
+  static_assert(AtomicResult<std::uint32_t, Health>::is_always_lock_free);
+  static_assert(AtomicResult<void, std::uint32_t>::is_always_lock_free);
+
+  AtomicResult<std::uint32_t, Health> status(Status(make_ok(1u)));
+  EXPECT_EQ(status.load().unwrap(), 1u);
+  status.store(make_err(Health::Down));
+  EXPECT_EQ(status.load().unwrap_err(), Health::Down);
+  status.store(make_ok(7u));
+  EXPECT_EQ(status.load().unwrap(), 7u);
+
+  Result<void, std::uint32_t> initial = make_ok();
+  AtomicResult<void, std::uint32_t> done(initial);
+  EXPECT_TRUE(done.load().is_ok());
+  done.store(make_err(3u));
+  EXPECT_EQ(done.load().unwrap_err(), 3u);
+}
+
+struct Snapshot {
+  std::uint64_t m_version;
+  std::uint64_t m_checksum;  // m_version から計算した値
+  std::uint64_t m_padding[2];
+};
+
+Snapshot make_snapshot(std::uint64_t version) {
+  return Snapshot{version, ~version, {version, version}};
+}
+
+bool consistent(const Snapshot& s) {
+  return s.m_checksum == ~s.m_version && s.m_padding[0] == s.m_version &&
+         s.m_padding[1] == s.m_version;
+}
+
+// シーケンスロックで保護される場合の一貫性をテスト
+TEST(AtomicResultTest, SeqLock) {
+  using Status = Result<Snapshot, std::uint64_t>;
+  static_assert(!AtomicResult<Snapshot, std::uint64_t>::is_always_lock_free);
+
+  AtomicResult<Snapshot, std::uint64_t> status(
+      Status(make_ok(make_snapshot(0))));
+  std::atomic<bool> stop{false};
+  std::atomic<int> torn{0};
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&] {
+      std::uint64_t last = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        auto r = status.load();
+        if (r.is_ok()) {
+          const auto& s = r.ref_ok();
+          if (!consistent(s) || s.m_version < last) {
+            ++torn;
+          }
+          last = s.m_version;
+        } else if (r.ref_err() < last) {
+          ++torn;
+        }
+      }
+    });
+  }
+
+  for (std::uint64_t version = 1; version <= 20000; ++version) {
+    if (version % 3 == 0) {
+      status.store(make_err(version));
+    } else {
+      status.store(make_ok(make_snapshot(version)));
+    }
+  }
+  stop = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(torn.load(), 0);
+  EXPECT_EQ(status.load().ref_ok().m_version, 20000u);
+}
+
+struct Range {
+  Range(std::uint32_t begin, std::uint32_t end) : m_begin(begin), m_end(end) {}
+
+  std::uint32_t m_begin;
+  std::uint32_t m_end;
+};
+
+struct Code {
+  explicit Code(std::uint16_t value) : m_value(value) {}
+
+  std::uint16_t m_value;
+};
+
+// デフォルト構築できない型を保持できるかテスト
+TEST(AtomicResultTest, NonDefaultConstructible) {
+  static_assert(!std::is_default_constructible_v<Range>);
+  using Status = Result<Range, Code>;
+  AtomicResult<Range, Code> status(Status(make_ok(Range(1, 2))));
+  EXPECT_EQ(status.load().unwrap().m_end, 2u);
+  status.store(make_err(Code(9)));
+  EXPECT_EQ(status.load().unwrap_err().m_value, 9u);
+}
+
+}  // namespace
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <t9_result/backtrace.h>
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+using namespace t9_result;
+
+enum class IoError {
+  NotFound,
+  Denied,
+};
+
+__attribute__((noinline)) Result<int, Traced<IoError>> open_file(bool found) {
+  if (!found) {
+    return make_err(IoError::NotFound);
+  }
+  return make_ok(3);
+}
+
+__attribute__((noinline)) Result<int, Traced<IoError>> recurse(int depth) {
+  if (depth == 0) {
+    return make_err_with<Traced<IoError>>(IoError::Denied);
+  }
+  auto result = recurse(depth - 1);
+  // 末尾呼び出しの最適化でフレームが消えないようにする
+  asm volatile("" ::: "memory");
+  return result;
+}
+
+// 失敗値の生成時に記録されることをテスト
+TEST(BacktraceTest, Capture) {
+  set_backtrace_enabled(true);
+  // 定数の引数で特殊化した open_file の複製が作られないようにする
+  volatile bool found = false;
+  auto result = open_file(found);
+  ASSERT_TRUE(result.is_err());
+  const Traced<IoError>& error = result.ref_err();
+  EXPECT_EQ(error.m_error, IoError::NotFound);
+  ASSERT_FALSE(error.m_backtrace.empty());
+
+  // Err や std::variant の内部を除き、先頭は open_file 内の戻りアドレス
+  // （最適化の有無によらない）
+  auto begin = reinterpret_cast<std::uintptr_t>(&open_file);
+  auto address = reinterpret_cast<std::uintptr_t>(error.m_backtrace[0]);
+  EXPECT_GT(address, begin);
+  EXPECT_LT(address, begin + 256);
+
+  // 起点がスタック上にない場合は呼び出し元から記録する
+  static const IoError kStatic = IoError::Denied;
+  auto fallback = Backtrace::capture_from(&kStatic);
+  EXPECT_GT(fallback.size(), 0u);
+
+  EXPECT_TRUE(open_file(true).is_ok());
+}
+
+// 記録するフレーム数の上限をテスト
+TEST(BacktraceTest, MaxFrames) {
+  auto shallow = Backtrace::capture();
+  EXPECT_GT(shallow.size(), 0u);
+  EXPECT_LE(shallow.size(), Backtrace::kMaxFrames);
+
+  auto result = recurse(Backtrace::kMaxFrames * 2);
+  EXPECT_EQ(result.ref_err().m_error, IoError::Denied);
+  EXPECT_EQ(result.ref_err().m_backtrace.size(), Backtrace::kMaxFrames);
+}
+
+// 記録の無効化をテスト
+TEST(BacktraceTest, Disabled) {
+  set_backtrace_enabled(false);
+  auto result = open_file(false);
+  set_backtrace_enabled(true);
+  EXPECT_EQ(result.ref_err().m_error, IoError::NotFound);
+  EXPECT_TRUE(result.ref_err().m_backtrace.empty());
+}
+
+// シンボル解決と文字列への変換をテスト
+TEST(BacktraceTest, Symbolize) {
+  // Debug ビルドでも gtest を経由した main まで kMaxFrames に収まる深さ
+  auto result = recurse(0);
+  const Backtrace& backtrace = result.ref_err().m_backtrace;
+
+  std::size_t frames = 0;
+  std::size_t with_module = 0;
+  backtrace.symbolize([&](const BacktraceFrame& frame) {
+    EXPECT_EQ(frame.m_address, backtrace[frames]);
+    ++frames;
+    with_module += frame.m_module != nullptr;
+  });
+  EXPECT_EQ(frames, backtrace.size());
+  EXPECT_EQ(with_module, frames);
+
+  std::string text = backtrace.to_string();
+  EXPECT_EQ(text.rfind("#0 0x", 0), 0u);
+  EXPECT_NE(text.find("t9_result_test"), std::string::npos);
+  // libc 内のフレームは動的シンボル表から関数名を解決できる
+  EXPECT_NE(text.find("__libc_start"), std::string::npos);
+}
+
+}  // namespace
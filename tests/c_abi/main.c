@@ -0,0 +1,51 @@
+/* C から t9_result_* を受け取るテストプログラム */
+#include <stdio.h>
+#include <string.h>
+
+#include "service.h"
+
+_Static_assert(sizeof(t9_result_i64) == 16, "t9_result_i64 layout");
+_Static_assert(sizeof(t9_status) == 4, "t9_status layout");
+
+static int failures = 0;
+
+#define CHECK(cond)                                              \
+  do {                                                           \
+    if (!(cond)) {                                               \
+      fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, \
+              #cond);                                            \
+      ++failures;                                                \
+    }                                                            \
+  } while (0)
+
+int main(void) {
+  t9_result_i64 parsed = service_parse("12345");
+  CHECK(T9_IS_OK(parsed));
+  CHECK(parsed.value == 12345);
+
+  t9_result_i64 empty = service_parse("");
+  CHECK(!T9_IS_OK(empty));
+  CHECK(empty.error == SERVICE_EMPTY);
+
+  CHECK(service_parse("12a").error == SERVICE_INVALID);
+  CHECK(service_parse("99999999999999999999").error == SERVICE_OVERFLOW);
+
+  CHECK(T9_IS_OK(service_check(1)));
+  CHECK(service_check(-1).error == SERVICE_INVALID);
+
+  t9_result_f64 ratio = service_ratio(1, 4);
+  CHECK(T9_IS_OK(ratio));
+  CHECK(ratio.value == 0.25);
+  CHECK(service_ratio(1, 0).error == SERVICE_INVALID);
+
+  const char* text = "key=value";
+  t9_result_ptr found = service_find(text, '=');
+  CHECK(T9_IS_OK(found));
+  CHECK(found.value == text + 3);
+  CHECK(service_find(text, '#').error == SERVICE_EMPTY);
+
+  if (failures == 0) {
+    printf("c_abi: all checks passed\n");
+  }
+  return failures == 0 ? 0 : 1;
+}
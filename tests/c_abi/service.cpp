@@ -0,0 +1,67 @@
+// C++ の Result で実装し、to_c() で C の構造体として返す
+#include "service.h"
+
+#include <t9_result/c_abi.h>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+using namespace t9_result;
+
+namespace {
+
+enum class ServiceError : std::int32_t {
+  Empty = SERVICE_EMPTY,
+  Invalid = SERVICE_INVALID,
+  Overflow = SERVICE_OVERFLOW,
+};
+
+Result<std::int64_t, ServiceError> parse(const char* text) {
+  if (*text == '\0') {
+    return make_err(ServiceError::Empty);
+  }
+  std::int64_t value = 0;
+  for (const char* p = text; *p; ++p) {
+    if (*p < '0' || *p > '9') {
+      return make_err(ServiceError::Invalid);
+    }
+    if (value > (std::numeric_limits<std::int64_t>::max() - (*p - '0')) / 10) {
+      return make_err(ServiceError::Overflow);
+    }
+    value = value * 10 + (*p - '0');
+  }
+  return make_ok(value);
+}
+
+}  // namespace
+
+extern "C" t9_result_i64 service_parse(const char* text) {
+  return to_c(parse(text));
+}
+
+extern "C" t9_status service_check(int64_t value) {
+  Result<void, ServiceError> result =
+      value < 0 ? Result<void, ServiceError>(make_err(ServiceError::Invalid))
+                : Result<void, ServiceError>(make_ok());
+  return to_c(result);
+}
+
+extern "C" t9_result_f64 service_ratio(int64_t numerator,
+                                       int64_t denominator) {
+  return to_c(parse("1").and_then([&](std::int64_t) {
+    if (denominator == 0) {
+      return Result<double, ServiceError>(make_err(ServiceError::Invalid));
+    }
+    return Result<double, ServiceError>(make_ok(
+        static_cast<double>(numerator) / static_cast<double>(denominator)));
+  }));
+}
+
+extern "C" t9_result_ptr service_find(const char* text, char c) {
+  const char* found = std::strchr(text, c);
+  Result<const char*, ServiceError> result =
+      found ? Result<const char*, ServiceError>(make_ok(found))
+            : Result<const char*, ServiceError>(make_err(ServiceError::Empty));
+  return to_c(result);
+}
@@ -0,0 +1,24 @@
+/* C から呼び出すテスト用のサービス（実装は service.cpp） */
+#pragma once
+
+#include <t9_result/c_result.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** service_parse / service_check の失敗値 */
+enum service_error {
+  SERVICE_EMPTY = 1,
+  SERVICE_INVALID = 2,
+  SERVICE_OVERFLOW = 3,
+};
+
+t9_result_i64 service_parse(const char* text);
+t9_status service_check(int64_t value);
+t9_result_f64 service_ratio(int64_t numerator, int64_t denominator);
+t9_result_ptr service_find(const char* text, char c);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <t9_result/c_abi.h>
+
+#include <cstdint>
+
+namespace {
+
+using namespace t9_result;
+
+enum class Code : std::int32_t {
+  NotFound = 1,
+  Denied = 2,
+};
+
+// 成功値の型と構造体の対応をテスト
+TEST(CAbiTest, Types) {
+  static_assert(std::is_same_v<c_result_t<void>, t9_status>);
+  static_assert(std::is_same_v<c_result_t<std::int32_t>, t9_result_i32>);
+  static_assert(std::is_same_v<c_result_t<std::int64_t>, t9_result_i64>);
+  static_assert(std::is_same_v<c_result_t<std::uint64_t>, t9_result_u64>);
+  static_assert(std::is_same_v<c_result_t<double>, t9_result_f64>);
+  static_assert(std::is_same_v<c_result_t<const char*>, t9_result_ptr>);
+  static_assert(sizeof(t9_result_i32) == 8);
+  static_assert(sizeof(t9_result_ptr) == 16);
+}
+
+// Result から構造体への変換と逆変換をテスト
+TEST(CAbiTest, RoundTrip) {
+  Result<std::int64_t, Code> ok = make_ok(std::int64_t{-42});
+  t9_result_i64 c_ok = to_c(ok);
+  EXPECT_TRUE(T9_IS_OK(c_ok));
+  EXPECT_EQ(c_ok.value, -42);
+  EXPECT_EQ((from_c<std::int64_t, Code>(c_ok).unwrap()), -42);
+
+  Result<std::int64_t, Code> err = make_err(Code::Denied);
+  t9_result_i64 c_err = to_c(err);
+  EXPECT_FALSE(T9_IS_OK(c_err));
+  EXPECT_EQ(c_err.error, 2);
+  EXPECT_EQ((from_c<std::int64_t, Code>(c_err).unwrap_err()), Code::Denied);
+
+  Result<void, Code> status = make_err(Code::NotFound);
+  EXPECT_EQ(to_c(status).error, 1);
+  EXPECT_TRUE((from_c<void, Code>(t9_status{T9_OK}).is_ok()));
+}
+
+// ポインタと浮動小数点数の変換をテスト
+TEST(CAbiTest, PointerAndDouble) {
+  const int values[2] = {1, 2};
+  Result<const int*, Code> pointer = make_ok(values + 1);
+  t9_result_ptr c_pointer = to_c(pointer);
+  EXPECT_EQ(c_pointer.value, values + 1);
+  EXPECT_EQ(*(from_c<const int*, Code>(c_pointer).unwrap()), 2);
+
+  Result<double, int> ratio = make_ok(0.5);
+  EXPECT_EQ(to_c(ratio).value, 0.5);
+  EXPECT_EQ((from_c<double, int>(t9_result_f64{1.5, T9_OK}).unwrap()), 1.5);
+  EXPECT_EQ((from_c<double, int>(t9_result_f64{0.0, 7}).unwrap_err()), 7);
+}
+
+}  // namespace
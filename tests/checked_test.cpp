@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include <t9_result/checked.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+template <typename T>
+using Limits = std::numeric_limits<T>;
+
+// 加算・減算・乗算をテスト
+TEST(CheckedTest, AddSubMul) {
+  EXPECT_EQ(checked_add(1, 2).unwrap(), 3);
+  EXPECT_EQ(checked_add(Limits<int>::max(), 1).unwrap_err(),
+            ArithError::Overflow);
+  EXPECT_EQ(checked_add(Limits<int>::min(), -1).unwrap_err(),
+            ArithError::Overflow);
+  EXPECT_EQ(checked_add(std::uint8_t{200}, std::uint8_t{56}).unwrap_err(),
+            ArithError::Overflow);
+  EXPECT_EQ(checked_add(std::uint8_t{200}, std::uint8_t{55}).unwrap(), 255);
+
+  EXPECT_EQ(checked_sub(0u, 1u).unwrap_err(), ArithError::Overflow);
+  EXPECT_EQ(checked_sub(Limits<std::int64_t>::min(), std::int64_t{1})
+                .unwrap_err(),
+            ArithError::Overflow);
+  EXPECT_EQ(checked_sub(-5, 7).unwrap(), -12);
+
+  EXPECT_EQ(checked_mul(std::int64_t{1} << 31, std::int64_t{1} << 31)
+                .unwrap(),
+            std::int64_t{1} << 62);
+  EXPECT_EQ(checked_mul(std::int64_t{1} << 32, std::int64_t{1} << 31)
+                .unwrap_err(),
+            ArithError::Overflow);
+  EXPECT_EQ(checked_mul(Limits<int>::min(), -1).unwrap_err(),
+            ArithError::Overflow);
+  EXPECT_EQ(checked_mul(-3, 4).unwrap(), -12);
+}
+
+// 除算をテスト
+TEST(CheckedTest, Div) {
+  EXPECT_EQ(checked_div(7, 2).unwrap(), 3);
+  EXPECT_EQ(checked_div(7, 0).unwrap_err(), ArithError::DivisionByZero);
+  EXPECT_EQ(checked_div(Limits<int>::min(), -1).unwrap_err(),
+            ArithError::Overflow);
+  EXPECT_EQ(checked_div(Limits<unsigned>::max(), 1u).unwrap(),
+            Limits<unsigned>::max());
+}
+
+// 整数型の変換をテスト
+TEST(CheckedTest, Cast) {
+  EXPECT_EQ(checked_cast<std::int8_t>(127).unwrap(), 127);
+  EXPECT_EQ(checked_cast<std::int8_t>(128).unwrap_err(),
+            ArithError::OutOfRange);
+  EXPECT_EQ(checked_cast<std::int8_t>(-129).unwrap_err(),
+            ArithError::OutOfRange);
+  EXPECT_EQ(checked_cast<std::uint8_t>(-1).unwrap_err(),
+            ArithError::OutOfRange);
+  EXPECT_EQ(checked_cast<std::uint64_t>(-1).unwrap_err(),
+            ArithError::OutOfRange);
+  EXPECT_EQ(checked_cast<std::uint64_t>(5).unwrap(), 5u);
+  EXPECT_EQ(checked_cast<std::int32_t>(Limits<std::uint32_t>::max())
+                .unwrap_err(),
+            ArithError::OutOfRange);
+  EXPECT_EQ(checked_cast<std::int64_t>(Limits<std::uint32_t>::max()).unwrap(),
+            std::int64_t{Limits<std::uint32_t>::max()});
+  EXPECT_EQ(checked_cast<std::int64_t>(Limits<std::uint64_t>::max())
+                .unwrap_err(),
+            ArithError::OutOfRange);
+  EXPECT_EQ(checked_cast<std::uint16_t>(std::uint64_t{65535}).unwrap(),
+            65535);
+  EXPECT_EQ(checked_cast<std::uint16_t>(std::uint64_t{65536}).unwrap_err(),
+            ArithError::OutOfRange);
+}
+
+// 配列の加算で最初に失敗した位置を返すことをテスト
+TEST(CheckedTest, BatchAdd) {
+  const std::size_t n = 1000;
+  std::vector<std::int32_t> a(n), b(n), out(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    a[i] = static_cast<std::int32_t>(i);
+    b[i] = static_cast<std::int32_t>(i * 2);
+  }
+  ASSERT_TRUE(checked_add_n(a.data(), b.data(), out.data(), n).is_ok());
+  EXPECT_EQ(out[999], 2997);
+
+  // 2番目のブロックの途中と後続のブロックで失敗させる
+  a[300] = Limits<std::int32_t>::max();
+  a[700] = Limits<std::int32_t>::max();
+  auto error = checked_add_n(a.data(), b.data(), out.data(), n);
+  ASSERT_TRUE(error.is_err());
+  EXPECT_EQ(error.ref_err().m_error, ArithError::Overflow);
+  EXPECT_EQ(error.ref_err().m_index, 300u);
+  EXPECT_EQ(out[299], 299 * 3);
+
+  // 入力と出力が同じ配列
+  std::vector<std::uint64_t> c = {1, 2, Limits<std::uint64_t>::max()};
+  std::vector<std::uint64_t> d = {1, 1, 1};
+  auto inplace = checked_add_n(c.data(), d.data(), c.data(), 3);
+  EXPECT_EQ(inplace.ref_err().m_index, 2u);
+  EXPECT_EQ(c[1], 3u);
+}
+
+// 配列の減算・乗算・除算をテスト
+TEST(CheckedTest, BatchSubMulDiv) {
+  std::vector<std::uint32_t> a = {10, 20, 30, 5};
+  std::vector<std::uint32_t> b = {1, 2, 3, 6};
+  std::vector<std::uint32_t> out(4);
+  EXPECT_EQ(checked_sub_n(a.data(), b.data(), out.data(), 4).ref_err().m_index,
+            3u);
+  EXPECT_EQ(out[2], 27u);
+
+  std::vector<std::int16_t> x(600, 100), y(600, 300), z(600);
+  EXPECT_TRUE(checked_mul_n(x.data(), x.data(), z.data(), 600).is_ok());
+  EXPECT_EQ(z[599], 10000);
+  y[599] = -400;
+  EXPECT_TRUE(checked_mul_n(x.data(), y.data(), z.data(), 599).is_ok());
+  EXPECT_EQ(z[0], 30000);
+  EXPECT_EQ(checked_mul_n(x.data(), y.data(), z.data(), 600).ref_err().m_index,
+            599u);
+
+  std::vector<std::int64_t> p = {Limits<std::int64_t>::max() / 2, 3, 1};
+  std::vector<std::int64_t> q = {2, 4, 1};
+  std::vector<std::int64_t> r(3);
+  EXPECT_TRUE(checked_mul_n(p.data(), q.data(), r.data(), 1).is_ok());
+  EXPECT_EQ(checked_mul_n(q.data(), p.data(), r.data(), 3).is_ok(), true);
+  p[2] = Limits<std::int64_t>::max();
+  q[2] = 2;
+  r[2] = 7;
+  EXPECT_EQ(checked_mul_n(p.data(), q.data(), r.data(), 3).ref_err().m_index,
+            2u);
+  EXPECT_EQ(r[2], 7) << "failing element must be left unchanged";
+
+  std::vector<int> n = {8, 9, Limits<int>::min(), 1};
+  std::vector<int> m = {2, 3, -1, 0};
+  std::vector<int> o(4);
+  auto divided = checked_div_n(n.data(), m.data(), o.data(), 4);
+  EXPECT_EQ(divided.ref_err().m_index, 2u);
+  EXPECT_EQ(divided.ref_err().m_error, ArithError::Overflow);
+  EXPECT_EQ(o[1], 3);
+}
+
+// 配列の変換をテスト
+TEST(CheckedTest, BatchCast) {
+  std::vector<std::int64_t> in(513);
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    in[i] = static_cast<std::int64_t>(i) - 256;
+  }
+  std::vector<std::int16_t> narrow(in.size());
+  EXPECT_TRUE(checked_cast_n(in.data(), narrow.data(), in.size()).is_ok());
+  EXPECT_EQ(narrow[0], -256);
+
+  std::vector<std::uint8_t> bytes(in.size());
+  auto negative = checked_cast_n(in.data(), bytes.data(), in.size());
+  EXPECT_EQ(negative.ref_err().m_error, ArithError::OutOfRange);
+  EXPECT_EQ(negative.ref_err().m_index, 0u);
+
+  std::vector<std::uint32_t> large = {1, 0x7FFFFFFF, 0x80000000};
+  std::vector<std::int32_t> signed_out(3);
+  EXPECT_EQ(checked_cast_n(large.data(), signed_out.data(), 3)
+                .ref_err()
+                .m_index,
+            2u);
+  EXPECT_EQ(signed_out[1], 0x7FFFFFFF);
+}
+
+// 16ビットの全ての値で配列の変換と checked_cast() の判定が一致するかテスト
+template <typename To, typename From>
+void expect_same_as_scalar() {
+  for (std::int32_t v = Limits<From>::min(); v <= Limits<From>::max(); ++v) {
+    auto value = static_cast<From>(v);
+    To out = 0;
+    EXPECT_EQ(checked_cast_n(&value, &out, 1).is_ok(),
+              checked_cast<To>(value).is_ok())
+        << v;
+  }
+}
+
+// int より狭い符号付き型同士の変換で範囲内の負の値を失敗と判定しないかテスト
+TEST(CheckedTest, BatchCastNarrowSigned) {
+  EXPECT_EQ(detail::cast_flag<std::int8_t>(std::int16_t{-128}), 0u);
+  EXPECT_EQ(detail::cast_flag<std::int8_t>(std::int16_t{-1}), 0u);
+  EXPECT_NE(detail::cast_flag<std::int8_t>(std::int16_t{-129}), 0u);
+  EXPECT_NE(detail::cast_flag<std::int8_t>(std::int16_t{128}), 0u);
+
+  std::vector<std::int16_t> in(300);
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    in[i] = static_cast<std::int16_t>(static_cast<int>(i % 256) - 128);
+  }
+  std::vector<std::int8_t> out(in.size());
+  EXPECT_TRUE(checked_cast_n(in.data(), out.data(), in.size()).is_ok());
+  EXPECT_EQ(out[0], -128);
+  EXPECT_EQ(out[255], 127);
+  in[299] = -129;
+  EXPECT_EQ(checked_cast_n(in.data(), out.data(), in.size()).ref_err().m_index,
+            299u);
+}
+
+TEST(CheckedTest, BatchCastMatchesScalar) {
+  expect_same_as_scalar<std::int8_t, std::int16_t>();
+  expect_same_as_scalar<std::uint8_t, std::int16_t>();
+  expect_same_as_scalar<std::uint16_t, std::int16_t>();
+  expect_same_as_scalar<std::int32_t, std::int16_t>();
+  expect_same_as_scalar<std::uint32_t, std::int16_t>();
+  expect_same_as_scalar<std::int8_t, std::uint16_t>();
+  expect_same_as_scalar<std::uint8_t, std::uint16_t>();
+  expect_same_as_scalar<std::int16_t, std::uint16_t>();
+  expect_same_as_scalar<std::int32_t, std::uint16_t>();
+}
+
+}  // namespace
@@ -0,0 +1,99 @@
+# オブジェクトファイルを逆アセンブルし、関数ごとの命令数を期待値と比較する
+#
+# 使い方:
+#   cmake -DOBJDUMP=<objdump> -DOBJECT=<obj> -DEXPECT=<expect> \
+#         [-DCOMPILER_ID=<GNU|Clang>] -P check_codegen.cmake
+#
+# 期待値ファイルの各行は "<関数名> <項目>[@<コンパイラ>]=<上限値>..." の形式。
+# コンパイラを指定した項目は COMPILER_ID が一致する場合のみ検査する。
+#   branches: 条件分岐命令(jcc)の数
+#   calls:    call命令の数
+#   insns:    命令数（アラインメント用のnopを除く）
+#   stack:    スタックを参照する命令の数（push/pop/%rsp/%rbp）
+
+foreach(var OBJDUMP OBJECT EXPECT)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "${var} is not specified")
+    endif()
+endforeach()
+
+execute_process(
+    COMMAND ${OBJDUMP} -d --no-show-raw-insn ${OBJECT}
+    OUTPUT_VARIABLE disassembly
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "objdump failed: ${result}")
+endif()
+
+# 関数ごとに命令を数える
+string(REPLACE ";" "," disassembly "${disassembly}")
+string(REPLACE "\n" ";" lines "${disassembly}")
+set(function "")
+foreach(line IN LISTS lines)
+    if(line MATCHES "^[0-9a-f]+ <([^>]+)>:$")
+        set(function "${CMAKE_MATCH_1}")
+        foreach(key branches calls insns stack)
+            set(count_${function}_${key} 0)
+        endforeach()
+    elseif(function AND line MATCHES "^ +[0-9a-f]+:\t([a-z0-9]+)(.*)$")
+        set(mnemonic "${CMAKE_MATCH_1}")
+        set(operands "${CMAKE_MATCH_2}")
+        # アラインメント用のパディングは数えない
+        if(mnemonic MATCHES "^(nop|data16|cs|int3)"
+           OR (mnemonic STREQUAL "xchg" AND operands MATCHES "%ax,%ax"))
+            continue()
+        endif()
+        math(EXPR count_${function}_insns "${count_${function}_insns} + 1")
+        if(mnemonic MATCHES "^j" AND NOT mnemonic MATCHES "^jmp")
+            math(EXPR count_${function}_branches "${count_${function}_branches} + 1")
+        elseif(mnemonic MATCHES "^call")
+            math(EXPR count_${function}_calls "${count_${function}_calls} + 1")
+        endif()
+        if(mnemonic MATCHES "^(push|pop)" OR operands MATCHES "%[re](sp|bp)")
+            math(EXPR count_${function}_stack "${count_${function}_stack} + 1")
+        endif()
+    endif()
+endforeach()
+
+# 期待値と比較する
+file(STRINGS ${EXPECT} expectations ENCODING UTF-8 REGEX "^[^#]")
+set(failed FALSE)
+foreach(expectation IN LISTS expectations)
+    string(REGEX MATCHALL "[^ \t]+" fields "${expectation}")
+    list(POP_FRONT fields function)
+    if(NOT DEFINED count_${function}_branches)
+        message(SEND_ERROR "${function}: not found in ${OBJECT}")
+        set(failed TRUE)
+        continue()
+    endif()
+    foreach(field IN LISTS fields)
+        if(NOT field MATCHES "^([a-z]+)(@([A-Za-z]+))?=([0-9]+)$")
+            message(SEND_ERROR "${function}: invalid field '${field}'")
+            set(failed TRUE)
+            continue()
+        endif()
+        set(key "${CMAKE_MATCH_1}")
+        set(compiler "${CMAKE_MATCH_3}")
+        set(limit "${CMAKE_MATCH_4}")
+        if(compiler AND NOT compiler STREQUAL "${COMPILER_ID}")
+            continue()
+        endif()
+        if(NOT DEFINED count_${function}_${key})
+            message(SEND_ERROR "${function}: unknown key '${key}'")
+            set(failed TRUE)
+            continue()
+        endif()
+        set(actual ${count_${function}_${key}})
+        if(actual GREATER limit)
+            message(SEND_ERROR "${function}: ${key} = ${actual} (expected <= ${limit})")
+            set(failed TRUE)
+        else()
+            message(STATUS "${function}: ${key} = ${actual} (<= ${limit})")
+        endif()
+    endforeach()
+endforeach()
+
+if(failed)
+    message(FATAL_ERROR "codegen check failed")
+endif()
@@ -0,0 +1,26 @@
+// ErrorMap の生成コードを検査するためのスニペット
+// 各関数の期待値は error_map_codegen.expect に記述する
+#include <t9_result/error_map.h>
+
+#include <cstdint>
+
+enum class IoError : std::uint8_t { NotFound, Denied, Timeout, Reset, Closed };
+enum class AppError : std::uint32_t { Missing = 7, Forbidden, Retry };
+
+template <>
+struct t9_result::EnumRange<IoError> {
+  static constexpr IoError first = IoError::NotFound;
+  static constexpr IoError last = IoError::Closed;
+};
+
+using IoToApp = t9_result::ErrorMap<
+    IoError, AppError,
+    t9_result::ErrorPair<IoError::NotFound, AppError::Missing>,
+    t9_result::ErrorPair<IoError::Denied, AppError::Forbidden>,
+    t9_result::ErrorPair<IoError::Timeout, AppError::Retry>,
+    t9_result::ErrorPair<IoError::Reset, AppError::Retry>,
+    t9_result::ErrorPair<IoError::Closed, AppError::Missing>>;
+
+extern "C" AppError translate_table(IoError error) {
+  return IoToApp{}(error);
+}
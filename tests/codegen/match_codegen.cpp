@@ -0,0 +1,21 @@
+// match関数の生成コードを検査するためのスニペット
+// 各関数の期待値は match_codegen.expect に記述する
+#include <t9_result/prelude.h>
+
+using namespace t9_result;
+
+extern "C" int match_int(const Result<int, int>& result) {
+  return result.match([](int x) { return x + 1; }, [](int x) { return -x; });
+}
+
+extern "C" long match_convertible(const Result<int, long>& result) {
+  return result.match([](int x) { return x; }, [](long x) { return x * 2; });
+}
+
+extern "C" int match_void(const Result<void, int>& result) {
+  return result.match([]() { return 0; }, [](int x) { return x; });
+}
+
+extern "C" void match_mutate(Result<int, int>& result) {
+  result.match([](int& x) { ++x; }, [](int& x) { --x; });
+}
@@ -0,0 +1,59 @@
+// Result の基本操作の生成コードを検査するためのスニペット
+// 各関数の期待値は result_codegen.expect に記述する
+#include <t9_result/prelude.h>
+
+#ifdef __clang__
+#pragma clang diagnostic ignored "-Wreturn-type-c-linkage"
+#endif
+
+using namespace t9_result;
+
+namespace {
+
+Result<int, int> parse(int x) {
+  if (x < 0) {
+    return make_err(-x);
+  }
+  return make_ok(x);
+}
+
+Result<int, int> validate(int x) {
+  if (x > 100) {
+    return make_err(x);
+  }
+  return make_ok(x * 2);
+}
+
+}  // namespace
+
+extern "C" Result<int, int> return_ok(int x) {
+  return make_ok(x);
+}
+
+extern "C" Result<int, int> return_checked(int x) {
+  return parse(x);
+}
+
+extern "C" bool result_is_ok(const Result<int, int>& result) {
+  return result.is_ok();
+}
+
+extern "C" int result_unwrap(Result<int, int> result) {
+  return result.unwrap();
+}
+
+extern "C" Result<int, int> propagate_error(int x) {
+  return parse(x).and_then(validate);
+}
+
+extern "C" Result<int, int> map_chain(Result<int, int> result) {
+  return result.map([](int x) { return x + 1; })
+      .map([](int x) { return x * 2; })
+      .map([](int x) { return x - 3; });
+}
+
+extern "C" Result<int, int> map_err_chain(Result<int, int> result) {
+  return result.map_err([](int x) { return x + 1; }).map([](int x) {
+    return x * 2;
+  });
+}
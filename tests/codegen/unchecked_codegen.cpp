@@ -0,0 +1,21 @@
+// 検査なしアクセサの生成コードを検査するためのスニペット
+// 各関数の期待値は unchecked_codegen.expect に記述する
+#include <t9_result/prelude.h>
+
+using namespace t9_result;
+
+extern "C" int unchecked_ok_int(const Result<int, int>& result) {
+  return result.unchecked_ok();
+}
+
+extern "C" int unchecked_err_int(const Result<int, int>& result) {
+  return result.unchecked_err();
+}
+
+extern "C" int unchecked_err_void(const Result<void, int>& result) {
+  return result.unchecked_err();
+}
+
+extern "C" int checked_then_unchecked(const Result<int, int>& result) {
+  return result.is_ok() ? result.unchecked_ok() : 0;
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <t9_result/compare.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+enum class ErrorCode : std::uint32_t {
+  NotFound = 1,
+  Timeout = 2,
+};
+
+using IntResult = Result<std::uint64_t, ErrorCode>;
+
+IntResult ok(std::uint64_t value) {
+  return make_ok(value);
+}
+
+IntResult err(ErrorCode code) {
+  return make_err(code);
+}
+
+// 等価比較をテスト
+TEST(CompareTest, Equal) {
+  EXPECT_EQ(ok(1), ok(1));
+  EXPECT_NE(ok(1), ok(2));
+  EXPECT_EQ(err(ErrorCode::Timeout), err(ErrorCode::Timeout));
+  EXPECT_NE(err(ErrorCode::Timeout), err(ErrorCode::NotFound));
+  // 成功値と失敗値はペイロードのバイト列が同じでも等しくない
+  EXPECT_NE(ok(1), err(ErrorCode::NotFound));
+
+  Result<void, int> v1 = make_ok();
+  Result<void, int> v2 = make_ok();
+  Result<void, int> e1 = make_err(1);
+  EXPECT_EQ(v1, v2);
+  EXPECT_NE(v1, e1);
+
+  // メンバごとの比較にフォールバックする型
+  using StringResult = Result<std::string, std::string>;
+  StringResult s1 = make_ok(std::string("a"));
+  StringResult s2 = make_err(std::string("a"));
+  StringResult s3 = make_ok(std::string("a"));
+  EXPECT_EQ(s1, s3);
+  EXPECT_NE(s1, s2);
+}
+
+// 順序付け（成功値が先）をテスト
+TEST(CompareTest, Order) {
+  std::vector<IntResult> values = {err(ErrorCode::Timeout), ok(3),
+                                   err(ErrorCode::NotFound), ok(1), ok(2)};
+  std::sort(values.begin(), values.end());
+  std::vector<IntResult> expected = {ok(1), ok(2), ok(3),
+                                     err(ErrorCode::NotFound),
+                                     err(ErrorCode::Timeout)};
+  EXPECT_EQ(values, expected);
+
+  EXPECT_LT(ok(100), err(ErrorCode::NotFound));
+  EXPECT_GT(err(ErrorCode::NotFound), ok(100));
+  EXPECT_LE(ok(1), ok(1));
+  EXPECT_GE(ok(2), ok(1));
+  EXPECT_FALSE(ok(1) < ok(1));
+}
+
+// ハッシュ値と非順序コンテナでの使用をテスト
+TEST(CompareTest, Hash) {
+  std::hash<IntResult> hash;
+  EXPECT_EQ(hash(ok(42)), hash(ok(42)));
+  EXPECT_NE(hash(ok(1)), hash(err(ErrorCode::NotFound)));
+
+  std::unordered_set<IntResult> set;
+  set.insert(ok(1));
+  set.insert(ok(1));
+  set.insert(err(ErrorCode::Timeout));
+  set.insert(err(ErrorCode::Timeout));
+  EXPECT_EQ(set.size(), 2u);
+  EXPECT_EQ(set.count(ok(1)), 1u);
+  EXPECT_EQ(set.count(ok(2)), 0u);
+
+  std::hash<Result<std::string, int>> string_hash;
+  Result<std::string, int> s1 = make_ok(std::string("key"));
+  Result<std::string, int> s2 = make_ok(std::string("key"));
+  EXPECT_EQ(string_hash(s1), string_hash(s2));
+}
+
+struct Point {
+  std::int32_t m_x;
+  std::int32_t m_y;
+};
+
+}  // namespace
+
+namespace t9_result {
+
+// パディングのない構造体をバイト列比較の対象にする
+template <>
+struct BitwiseComparable<Point> {
+  static constexpr bool value = true;
+};
+
+}  // namespace t9_result
+
+namespace {
+
+// 特殊化したトレイトによる比較とハッシュをテスト
+TEST(CompareTest, BitwiseOptIn) {
+  Result<Point, int> a = make_ok(Point{1, 2});
+  Result<Point, int> b = make_ok(Point{1, 2});
+  Result<Point, int> c = make_ok(Point{2, 1});
+  EXPECT_TRUE(a == b);
+  EXPECT_FALSE(a == c);
+  std::hash<Result<Point, int>> hash;
+  EXPECT_EQ(hash(a), hash(b));
+  EXPECT_NE(hash(a), hash(c));
+}
+
+}  // namespace
@@ -0,0 +1,19 @@
+// 変換元の値が重複した ErrorMap はコンパイルエラーになる
+#include <t9_result/error_map.h>
+
+enum class From { A, B };
+enum class To { X, Y };
+
+template <>
+struct t9_result::EnumRange<From> {
+  static constexpr From first = From::A;
+  static constexpr From last = From::B;
+};
+
+using Duplicate =
+    t9_result::ErrorMap<From, To, t9_result::ErrorPair<From::A, To::X>,
+                        t9_result::ErrorPair<From::A, To::Y>>;
+
+To translate(From from) {
+  return Duplicate{}(from);
+}
@@ -0,0 +1,19 @@
+// 変換元の値が欠けた ErrorMap はコンパイルエラーになる
+#include <t9_result/error_map.h>
+
+enum class From { A, B, C };
+enum class To { X, Y };
+
+template <>
+struct t9_result::EnumRange<From> {
+  static constexpr From first = From::A;
+  static constexpr From last = From::C;
+};
+
+using Incomplete =
+    t9_result::ErrorMap<From, To, t9_result::ErrorPair<From::A, To::X>,
+                        t9_result::ErrorPair<From::B, To::Y>>;
+
+To translate(From from) {
+  return Incomplete{}(from);
+}
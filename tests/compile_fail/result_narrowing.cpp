@@ -0,0 +1,8 @@
+// 縮小変換となる失敗値からの Result の変換はオーバーロード解決で除外される
+#include <t9_result/result.h>
+
+#include <cstdint>
+
+t9_result::Result<int, std::int8_t> parse() {
+  return t9_result::make_err(1000);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <t9_result/deadline.h>
+#include <t9_result/one_of.h>
+
+#include <chrono>
+#include <thread>
+
+namespace {
+
+using namespace t9_result;
+using namespace std::chrono_literals;
+
+using Clock = Deadline::Clock;
+
+enum class ParseError {
+  Invalid,
+};
+
+using Error = OneOf<Timeout, ParseError>;
+
+// 期限の生成と比較をテスト
+TEST(DeadlineTest, Basic) {
+  auto now = Clock::now();
+  Deadline past(now - 1ms);
+  EXPECT_TRUE(past.expired());
+  EXPECT_EQ(past.remaining(), Clock::duration::zero());
+  EXPECT_TRUE(past.check().is_err());
+
+  auto soon = Deadline::after(1h);
+  EXPECT_FALSE(soon.expired());
+  EXPECT_GT(soon.remaining(), 59min);
+  EXPECT_TRUE(soon.check().is_ok());
+
+  EXPECT_TRUE(Deadline::never().is_never());
+  EXPECT_FALSE(Deadline::never().expired(Clock::time_point::max()));
+  EXPECT_EQ(Deadline::never().remaining(), Clock::duration::max());
+  EXPECT_EQ(Deadline::after(std::chrono::hours::max()), Deadline::never());
+
+  EXPECT_EQ(soon.earliest(past), past);
+  EXPECT_EQ(Deadline::never().earliest(soon), soon);
+  EXPECT_TRUE(past < soon);
+}
+
+Result<int, Error> parse(const char* text) {
+  if (text[0] < '0' || text[0] > '9') {
+    return make_err(ParseError::Invalid);
+  }
+  return make_ok(text[0] - '0');
+}
+
+// and_then のチェーンで期限が伝播するかテスト
+TEST(DeadlineTest, Within) {
+  int calls = 0;
+  auto twice = [&calls](int value) -> Result<int, Error> {
+    ++calls;
+    return make_ok(value * 2);
+  };
+  Deadline seen = Deadline::never();
+  auto record = [&seen](int value, Deadline deadline) -> Result<int, Error> {
+    seen = deadline;
+    return make_ok(value + 1);
+  };
+
+  auto soon = Deadline::after(1h);
+  auto result = parse("4")
+                    .and_then(within(soon, twice))
+                    .and_then(within(soon, record));
+  EXPECT_EQ(result.unwrap(), 9);
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(seen, soon);
+
+  Deadline past(Clock::now() - 1ms);
+  auto timed_out = parse("4")
+                       .and_then(within(past, twice))
+                       .and_then(within(past, record));
+  EXPECT_TRUE(timed_out.ref_err().holds<Timeout>());
+  EXPECT_EQ(calls, 1);
+
+  // 期限切れより前の失敗はそのまま伝播する
+  auto invalid = parse("x").and_then(within(past, twice));
+  EXPECT_TRUE(invalid.ref_err().holds<ParseError>());
+
+  Result<void, Timeout> done = make_ok();
+  auto check = [] { return Deadline::never().check(); };
+  EXPECT_TRUE(done.and_then(within(past, check)).is_err());
+  EXPECT_TRUE(done.and_then(within(soon, check)).is_ok());
+}
+
+// OnceResult の設定と待機をテスト
+TEST(DeadlineTest, OnceResult) {
+  OnceResult<int, ParseError> once;
+  EXPECT_EQ(once.try_get(), nullptr);
+  EXPECT_TRUE(once.wait(Deadline::after(10ms)).is_err());
+
+  std::thread producer([&once] {
+    std::this_thread::sleep_for(5ms);
+    EXPECT_TRUE(once.set(make_ok(42)));
+  });
+  auto waited = once.wait(Deadline::after(10s));
+  ASSERT_TRUE(waited.is_ok());
+  EXPECT_EQ(waited.unwrap().ref_ok(), 42);
+  producer.join();
+
+  EXPECT_FALSE(once.set(make_err(ParseError::Invalid)));
+  EXPECT_EQ(once.try_get()->ref_ok(), 42);
+  EXPECT_EQ(&once.wait(), once.try_get());
+  EXPECT_EQ(&once.wait(Deadline(Clock::now() - 1ms)).unwrap(), once.try_get());
+}
+
+}  // namespace
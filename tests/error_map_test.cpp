@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <t9_result/error_map.h>
+#include <t9_result/result.h>
+
+#include <cstdint>
+
+namespace io {
+
+enum class Error : std::uint8_t {
+  NotFound,
+  Denied,
+  Timeout,
+};
+
+}  // namespace io
+
+namespace app {
+
+enum class Error {
+  Missing = 100,
+  Forbidden = 200,
+  Unavailable = 300,
+};
+
+}  // namespace app
+
+template <>
+struct t9_result::EnumRange<io::Error> {
+  static constexpr io::Error first = io::Error::NotFound;
+  static constexpr io::Error last = io::Error::Timeout;
+};
+
+namespace {
+
+using namespace t9_result;
+
+using IoToApp =
+    ErrorMap<io::Error, app::Error,
+             ErrorPair<io::Error::Timeout, app::Error::Unavailable>,
+             ErrorPair<io::Error::NotFound, app::Error::Missing>,
+             ErrorPair<io::Error::Denied, app::Error::Forbidden>>;
+
+// コンパイル時の変換をテスト
+static_assert(IoToApp{}(io::Error::NotFound) == app::Error::Missing);
+static_assert(IoToApp{}(io::Error::Timeout) == app::Error::Unavailable);
+
+// 変換表による変換をテスト
+TEST(ErrorMapTest, Translate) {
+  IoToApp map;
+  EXPECT_EQ(map(io::Error::NotFound), app::Error::Missing);
+  EXPECT_EQ(map(io::Error::Denied), app::Error::Forbidden);
+  EXPECT_EQ(map(io::Error::Timeout), app::Error::Unavailable);
+}
+
+// map_err に渡せることをテスト
+TEST(ErrorMapTest, MapErr) {
+  Result<int, io::Error> failed = make_err(io::Error::Denied);
+  auto mapped = std::move(failed).map_err(IoToApp{});
+  static_assert(
+      std::is_same_v<decltype(mapped), Result<int, app::Error>>);
+  EXPECT_EQ(mapped.unwrap_err(), app::Error::Forbidden);
+
+  Result<void, io::Error> ok = make_ok();
+  EXPECT_TRUE(std::move(ok).map_err(IoToApp{}).is_ok());
+}
+
+}  // namespace
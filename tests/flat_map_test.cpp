@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include <t9_result/flat_map.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace {
+
+using namespace t9_result;
+
+// 挿入と検索をテスト
+TEST(FlatMapTest, InsertAndGet) {
+  FlatMap<int, std::string> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.try_get(1).is_err());
+
+  auto& value = map.try_insert(1, "one").unwrap();
+  EXPECT_EQ(value, "one");
+  value = "uno";
+  EXPECT_EQ(map.try_get(1).unwrap(), "uno");
+  EXPECT_TRUE(map.contains(1));
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_EQ(map.size(), 1u);
+
+  auto exists = map.try_insert(1, "ichi");
+  ASSERT_TRUE(exists.is_err());
+  EXPECT_EQ(exists.unwrap_err(), InsertError::KeyExists);
+  EXPECT_EQ(map.try_get(1).unwrap(), "uno");
+
+  EXPECT_EQ(map.try_insert_or_assign(1, "ichi").unwrap(), "ichi");
+  EXPECT_EQ(map.try_insert_or_assign(2, "ni").unwrap(), "ni");
+  EXPECT_EQ(map.size(), 2u);
+
+  const auto& cmap = map;
+  EXPECT_EQ(cmap.try_get(2).unwrap(), "ni");
+  EXPECT_TRUE(cmap.try_get(3).is_err());
+}
+
+// 拡張を伴う多数の挿入をテスト
+TEST(FlatMapTest, Grow) {
+  FlatMap<std::size_t, std::size_t> map;
+  constexpr std::size_t kCount = 10000;
+  for (std::size_t i = 0; i < kCount; ++i) {
+    ASSERT_TRUE(map.try_insert(i, i * 2).is_ok());
+  }
+  EXPECT_EQ(map.size(), kCount);
+  EXPECT_GE(map.capacity(), kCount);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    ASSERT_EQ(map.try_get(i).unwrap(), i * 2);
+  }
+  EXPECT_TRUE(map.try_get(kCount).is_err());
+
+  // キーは const で渡され、値のみ変更できる
+  map.for_each([](const std::size_t& key, std::size_t& value) {
+    value += key;
+  });
+  std::size_t sum = 0;
+  const auto& cmap = map;
+  cmap.for_each([&sum](const std::size_t&, const std::size_t& value) {
+    sum += value;
+  });
+  EXPECT_EQ(sum, 3 * kCount * (kCount - 1) / 2);
+}
+
+// 削除と再挿入をテスト
+TEST(FlatMapTest, Erase) {
+  FlatMap<int, int> map;
+  for (int i = 0; i < 1000; ++i) {
+    map.try_insert(i, i);
+  }
+  for (int i = 0; i < 1000; i += 2) {
+    EXPECT_TRUE(map.erase(i));
+  }
+  EXPECT_FALSE(map.erase(0));
+  EXPECT_EQ(map.size(), 500u);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(map.contains(i), i % 2 == 1);
+  }
+
+  // 削除済みスロットが残った状態で挿入と削除を繰り返しても容量は増えない
+  std::size_t capacity = map.capacity();
+  for (int round = 0; round < 100; ++round) {
+    for (int i = 0; i < 1000; i += 2) {
+      ASSERT_TRUE(map.try_insert(i, round).is_ok());
+    }
+    for (int i = 0; i < 1000; i += 2) {
+      ASSERT_TRUE(map.erase(i));
+    }
+  }
+  EXPECT_EQ(map.capacity(), capacity);
+  EXPECT_EQ(map.size(), 500u);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_EQ(map.capacity(), capacity);
+}
+
+struct ConstantHash {
+  std::size_t operator()(int) const {
+    return 0;
+  }
+};
+
+// すべてのキーが衝突する場合をテスト
+TEST(FlatMapTest, Collision) {
+  FlatMap<int, int, ConstantHash> map;
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(map.try_insert(i, -i).is_ok());
+  }
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(map.try_get(i).unwrap(), -i);
+  }
+  EXPECT_TRUE(map.erase(50));
+  EXPECT_FALSE(map.contains(50));
+  EXPECT_EQ(map.try_get(99).unwrap(), -99);
+}
+
+// ムーブのみ可能な値とムーブ構築をテスト
+TEST(FlatMapTest, MoveOnly) {
+  FlatMap<std::string, std::unique_ptr<int>> map;
+  ASSERT_TRUE(map.reserve(100).is_ok());
+  std::size_t capacity = map.capacity();
+  for (int i = 0; i < 100; ++i) {
+    map.try_emplace(std::to_string(i), std::make_unique<int>(i));
+  }
+  EXPECT_EQ(map.capacity(), capacity);
+
+  auto moved = std::move(map);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(*moved.try_get("42").unwrap(), 42);
+}
+
+// 変換を数えるキー
+struct CountedKey {
+  static inline int s_conversions = 0;
+
+  int m_value;
+
+  struct Source {
+    int m_value;
+  };
+
+  CountedKey(int value) : m_value(value) {}
+  CountedKey(Source source) : m_value(source.m_value) {
+    ++s_conversions;
+  }
+
+  bool operator==(const CountedKey& other) const {
+    return m_value == other.m_value;
+  }
+};
+
+struct CountedKeyHash {
+  std::size_t operator()(const CountedKey& key) const {
+    return static_cast<std::size_t>(key.m_value);
+  }
+};
+
+// 異なる型のキーは一度だけ変換されることをテスト
+TEST(FlatMapTest, EmplaceConvertsKeyOnce) {
+  FlatMap<CountedKey, int, CountedKeyHash> map;
+  CountedKey::s_conversions = 0;
+  ASSERT_TRUE(map.try_emplace(CountedKey::Source{1}, 10).is_ok());
+  EXPECT_EQ(CountedKey::s_conversions, 1);
+  EXPECT_TRUE(map.try_emplace(CountedKey::Source{1}, 20).is_err());
+  EXPECT_EQ(CountedKey::s_conversions, 2);
+  EXPECT_EQ(map.try_get(1).unwrap(), 10);
+}
+
+// 拡張を伴う挿入で自身の要素を引数にできることをテスト
+TEST(FlatMapTest, EmplaceFromOwnElement) {
+  FlatMap<int, std::string> map;
+  int key = 0;
+  ASSERT_TRUE(map.try_emplace(key, std::string(100, 'x')).is_ok());
+  // 容量に達するまで埋め、次の挿入で必ず拡張させる
+  std::size_t capacity = map.capacity();
+  while (map.capacity() == capacity) {
+    const std::string& first = map.try_get(0).unwrap();
+    ASSERT_TRUE(map.try_emplace(++key, first).is_ok());
+  }
+  for (int i = 0; i <= key; ++i) {
+    ASSERT_EQ(map.try_get(i).unwrap(), std::string(100, 'x'));
+  }
+}
+
+}  // namespace
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <t9_result/function.h>
+#include <t9_result/result.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+int twice(int value) {
+  return value * 2;
+}
+
+int apply(FunctionRef<int(int)> f, int value) {
+  return f(value);
+}
+
+// ラムダ・関数ポインタ・関数オブジェクトの参照をテスト
+TEST(FunctionRefTest, Call) {
+  int offset = 10;
+  EXPECT_EQ(apply([&offset](int v) { return v + offset; }, 1), 11);
+  EXPECT_EQ(apply(twice, 3), 6);
+  EXPECT_EQ(apply(&twice, 4), 8);
+
+  struct Negate {
+    int operator()(int v) const {
+      return -v;
+    }
+  };
+  const Negate negate;
+  EXPECT_EQ(apply(negate, 5), -5);
+
+  // 戻り値を捨てる呼び出しと参照引数
+  std::vector<int> log;
+  auto push = [&log](int v) { log.push_back(v); };
+  FunctionRef<void(int)> ref = push;
+  ref(1);
+  ref(2);
+  EXPECT_EQ(log, (std::vector<int>{1, 2}));
+}
+
+// Result のコンビネータに渡せることをテスト
+TEST(FunctionRefTest, ResultCombinator) {
+  std::vector<std::string> errors;
+  auto sink = [&errors](const std::string& e) { errors.push_back(e); };
+  FunctionRef<void(const std::string&)> on_error = sink;
+
+  Result<int, std::string> r = make_err(std::string("failed"));
+  r.inspect_err(on_error);
+  EXPECT_EQ(errors, (std::vector<std::string>{"failed"}));
+
+  auto length = [](const std::string& e) { return e.size(); };
+  FunctionRef<std::size_t(const std::string&)> to_code = length;
+  auto mapped = std::move(r).map_err(to_code);
+  EXPECT_EQ(mapped.unwrap_err(), 6u);
+}
+
+// 呼び出しと状態の保持をテスト
+TEST(UniqueFunctionTest, Call) {
+  UniqueFunction<int()> empty;
+  EXPECT_FALSE(empty);
+
+  UniqueFunction<int()> counter = [count = 0]() mutable { return ++count; };
+  ASSERT_TRUE(counter);
+  EXPECT_EQ(counter(), 1);
+  EXPECT_EQ(counter(), 2);
+
+  UniqueFunction<int(int)> pointer = &twice;
+  EXPECT_EQ(pointer(21), 42);
+}
+
+// 値を返す呼び出し可能オブジェクトを void のシグネチャに渡せることをテスト
+TEST(FunctionTest, DiscardReturnValue) {
+  int calls = 0;
+  auto doubled = [&calls](int x) {
+    ++calls;
+    return x * 2;
+  };
+  FunctionRef<void(int)> ref = doubled;
+  ref(1);
+  FunctionRef<void(int)> pointer = twice;
+  pointer(2);
+
+  UniqueFunction<void(int)> owned = doubled;
+  owned(3);
+  UniqueFunction<void(int)> owned_pointer = &twice;
+  owned_pointer(4);
+  EXPECT_EQ(calls, 2);
+}
+
+// ムーブのみ可能なキャプチャとムーブ・破棄をテスト
+TEST(UniqueFunctionTest, Move) {
+  auto value = std::make_shared<int>(7);
+  std::weak_ptr<int> watch = value;
+  {
+    auto owned = std::make_unique<std::shared_ptr<int>>(std::move(value));
+    UniqueFunction<int()> f = [p = std::move(owned)] { return **p; };
+    EXPECT_EQ(f(), 7);
+
+    UniqueFunction<int()> g = std::move(f);
+    EXPECT_FALSE(f);
+    ASSERT_TRUE(g);
+    EXPECT_EQ(g(), 7);
+
+    UniqueFunction<int()> h = [] { return 0; };
+    h = std::move(g);
+    EXPECT_EQ(h(), 7);
+    EXPECT_FALSE(watch.expired());
+  }
+  EXPECT_TRUE(watch.expired());
+}
+
+// 長く保持するコールバックとして Result の処理に使用する
+TEST(UniqueFunctionTest, ErrorHook) {
+  int reported = 0;
+  UniqueFunction<void(const int&)> hook = [&reported](const int& e) {
+    reported += e;
+  };
+  Result<int, int> a = make_err(3);
+  Result<int, int> b = make_ok(1);
+  a.inspect_err(hook);
+  b.inspect_err(hook);
+  EXPECT_EQ(reported, 3);
+}
+
+}  // namespace
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <t9_result/latency.h>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+// バケットの番号と上限値の対応をテスト
+TEST(LatencyHistogramTest, Buckets) {
+  std::size_t previous = 0;
+  for (std::uint64_t value = 0; value < (1u << 20); value += 7) {
+    std::size_t bucket = LatencyHistogram::bucket_of(value);
+    EXPECT_GE(bucket, previous);
+    EXPECT_LE(value, LatencyHistogram::upper_bound_of(bucket));
+    if (bucket > 0) {
+      EXPECT_GT(value, LatencyHistogram::upper_bound_of(bucket - 1));
+    }
+    previous = bucket;
+  }
+  EXPECT_EQ(LatencyHistogram::bucket_of(~std::uint64_t{0}),
+            LatencyHistogram::kBucketCount - 1);
+}
+
+// 分位点をテスト
+TEST(LatencyHistogramTest, Percentile) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.percentile(0.5), 0u);
+  for (std::uint64_t i = 1; i <= 1000; ++i) {
+    histogram.record(i * 1000);
+  }
+  EXPECT_EQ(histogram.count(), 1000u);
+  EXPECT_EQ(histogram.max(), 1000000u);
+  // 相対誤差は 1/16 以内
+  auto near = [](std::uint64_t actual, std::uint64_t expected) {
+    return actual >= expected && actual <= expected + expected / 16;
+  };
+  EXPECT_TRUE(near(histogram.percentile(0.5), 500000));
+  EXPECT_TRUE(near(histogram.percentile(0.99), 990000));
+  EXPECT_EQ(histogram.percentile(1.0), 1000000u);
+
+  LatencyHistogram other;
+  other.record(5);
+  histogram.merge(other);
+  EXPECT_EQ(histogram.count(), 1001u);
+  EXPECT_EQ(histogram.percentile(0.0), 5u);
+}
+
+Result<int, std::string> succeed() {
+  return make_ok(1);
+}
+
+Result<int, std::string> fail() {
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  return make_err(std::string("timeout"));
+}
+
+// 成功・失敗に分けて記録されることをテスト
+TEST(LatencySiteTest, Timed) {
+  LatencySite site("latency_test.timed");
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(timed(site, succeed).unwrap(), 1);
+  }
+  EXPECT_EQ(timed(site, fail).unwrap_err(), "timeout");
+
+  auto snapshot = site.snapshot();
+  EXPECT_EQ(snapshot.m_ok.count(), 10u);
+  EXPECT_EQ(snapshot.m_err.count(), 1u);
+  EXPECT_GE(snapshot.m_err.percentile(0.5), 2000000u);
+  EXPECT_LT(snapshot.m_ok.percentile(0.99), snapshot.m_err.percentile(0.5));
+}
+
+enum class DbError {
+  NotFound = 2,
+  Locked = 5,
+};
+
+struct Errno {
+  int m_value;
+
+  int code() const {
+    return m_value;
+  }
+};
+
+// 失敗値のコードごとに記録されることをテスト
+TEST(LatencySiteTest, ErrorCodes) {
+  LatencySite site("latency_test.error_codes");
+  auto lookup = [](DbError error) -> Result<int, DbError> {
+    return make_err(error);
+  };
+  timed(site, [&] { return lookup(DbError::Locked); });
+  timed(site, [&] { return lookup(DbError::Locked); });
+  timed(site, [&] { return lookup(DbError::NotFound); });
+  timed(site, [] { return Result<void, Errno>(make_err(Errno{1000})); });
+  timed(site, [] { return Result<void, int>(make_err(-1)); });
+  timed(site, [] { return Result<void, int>(make_ok()); });
+
+  auto snapshot = site.snapshot();
+  EXPECT_EQ(snapshot.m_err.count(), 5u);
+  EXPECT_EQ(snapshot.m_error_codes[5], 2u);
+  EXPECT_EQ(snapshot.m_error_codes[2], 1u);
+  EXPECT_EQ(snapshot.m_error_codes[0], 0u);
+  // 範囲外のコードはまとめて数える
+  EXPECT_EQ(snapshot.m_error_codes[LatencySite::kErrorCodeCount], 2u);
+
+  // コードを持たない失敗値は件数のみ記録する
+  LatencySite untyped("latency_test.untyped");
+  timed(untyped, fail);
+  auto counted = untyped.snapshot();
+  EXPECT_EQ(counted.m_err.count(), 1u);
+  for (std::uint64_t n : counted.m_error_codes) {
+    EXPECT_EQ(n, 0u);
+  }
+}
+
+// 複数スレッドの記録の合算をテスト
+TEST(LatencySiteTest, Threads) {
+  LatencySite site("latency_test.threads");
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&site, t] {
+      for (int i = 0; i < 1000; ++i) {
+        site.record(i % 10 != 0, 100 * (t + 1));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto snapshot = site.snapshot();
+  EXPECT_EQ(snapshot.m_ok.count(), 3600u);
+  EXPECT_EQ(snapshot.m_err.count(), 400u);
+  EXPECT_EQ(snapshot.m_ok.max(), 400u);
+  EXPECT_EQ(snapshot.m_ok.sum(), 900u * (100 + 200 + 300 + 400));
+}
+
+// 登録と削除をテスト
+TEST(LatencySiteTest, Registry) {
+  auto contains = [](const std::string& name) {
+    bool found = false;
+    LatencyRegistry::instance().for_each([&](LatencySite& site) {
+      found = found || name == site.name();
+    });
+    return found;
+  };
+  {
+    LatencySite site("latency_test.registry");
+    EXPECT_TRUE(contains("latency_test.registry"));
+  }
+  EXPECT_FALSE(contains("latency_test.registry"));
+}
+
+}  // namespace
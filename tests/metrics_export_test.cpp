@@ -0,0 +1,297 @@
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <t9_result/metrics_export.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+std::string temporary_path(const char* name) {
+  return "/tmp/t9_result_" + std::to_string(::getpid()) + "_" + name;
+}
+
+// ローカルのスクレイパーの代わりにソケットへ接続して全体を読み出す
+std::string scrape(const std::string& path) {
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  std::strcpy(address.sun_path, path.c_str());
+  if (::connect(fd, reinterpret_cast<sockaddr*>(&address),
+                sizeof(address)) != 0) {
+    ::close(fd);
+    return {};
+  }
+  std::string text;
+  char buffer[4096];
+  ssize_t n;
+  while ((n = ::read(fd, buffer, sizeof(buffer))) > 0) {
+    text.append(buffer, static_cast<std::size_t>(n));
+  }
+  ::close(fd);
+  return text;
+}
+
+std::string read_file(const std::string& path) {
+  std::ifstream file(path);
+  std::stringstream stream;
+  stream << file.rdbuf();
+  return stream.str();
+}
+
+std::size_t count_of(const std::string& text, const std::string& pattern) {
+  std::size_t count = 0;
+  for (auto i = text.find(pattern); i != std::string::npos;
+       i = text.find(pattern, i + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+// Prometheus 形式への変換をテスト
+TEST(MetricsExportTest, Prometheus) {
+  LatencySite site("export.\"quoted\"");
+  site.record(true, 100);
+  site.record(true, 100);
+  site.record(true, 1000);
+  site.record(false, 5000);
+  site.record_error_code(3);
+  site.record_error_code(3);
+  site.record_error_code(200);
+  LatencySite other("export.other");
+  other.record(false, 10);
+
+  std::string text;
+  format_metrics(MetricsFormat::Prometheus, text);
+
+  const std::string ok = "{site=\"export.\\\"quoted\\\"\",outcome=\"ok\"";
+  const std::string err = "{site=\"export.\\\"quoted\\\"\",outcome=\"err\"";
+  EXPECT_NE(text.find("t9_result_calls_total" + ok + "} 3\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("t9_result_calls_total" + err + "} 1\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("t9_result_errors_total{site=\"export.\\\"quoted\\\"\","
+                      "code=\"3\"} 2\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("t9_result_errors_total{site=\"export.\\\"quoted\\\"\","
+                      "code=\"other\"} 1\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("t9_result_latency_nanoseconds_bucket" + ok +
+                      ",le=\"255\"} 2\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("t9_result_latency_nanoseconds_bucket" + ok +
+                      ",le=\"1023\"} 3\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("t9_result_latency_nanoseconds_bucket" + ok +
+                      ",le=\"+Inf\"} 3\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("t9_result_latency_nanoseconds_sum" + ok + "} 1200\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("t9_result_latency_nanoseconds_count" + err + "} 1\n"),
+            std::string::npos);
+
+  // 件数0を含め、すべての系列が同じ le の集合を持つ
+  EXPECT_NE(text.find("t9_result_latency_nanoseconds_bucket" + err +
+                      ",le=\"15\"} 0\n"),
+            std::string::npos);
+  std::size_t buckets = count_of(text, "_bucket" + ok);
+  EXPECT_EQ(buckets, count_of(text, "_bucket" + err));
+  EXPECT_EQ(buckets, count_of(text, "_bucket{site=\"export.other\","
+                                    "outcome=\"ok\""));
+
+  // 各メトリクスは HELP と TYPE に続けて1か所にまとめて出力される
+  auto type_calls = text.find("# TYPE t9_result_calls_total counter\n");
+  auto type_errors = text.find("# TYPE t9_result_errors_total counter\n");
+  auto type_latency =
+      text.find("# TYPE t9_result_latency_nanoseconds histogram\n");
+  ASSERT_NE(type_calls, std::string::npos);
+  ASSERT_NE(type_errors, std::string::npos);
+  ASSERT_NE(type_latency, std::string::npos);
+  EXPECT_EQ(count_of(text, "# TYPE "), 3u);
+  EXPECT_EQ(count_of(text, "# HELP "), 3u);
+  EXPECT_LT(text.rfind("t9_result_calls_total{"), type_errors);
+  EXPECT_LT(text.rfind("t9_result_errors_total{"), type_latency);
+  EXPECT_GT(text.find("t9_result_calls_total{"), type_calls);
+  EXPECT_GT(text.find("t9_result_latency_nanoseconds_"), type_latency);
+}
+
+// JSON 形式への変換をテスト
+TEST(MetricsExportTest, Json) {
+  LatencySite site("export.json");
+  site.record(true, 10);
+  site.record(false, 20);
+  site.record(false, 20);
+  site.record_error_code(5);
+  site.record_error_code(5);
+
+  std::string text;
+  format_metrics(MetricsFormat::Json, text);
+
+  EXPECT_EQ(text.rfind("{\"sites\":[", 0), 0u);
+  EXPECT_NE(text.find("{\"name\":\"export.json\","
+                      "\"ok\":{\"count\":1,\"sum\":10,\"max\":10,"
+                      "\"p50\":10,\"p99\":10,\"buckets\":[[10,1]]},"
+                      "\"err\":{\"count\":2,\"sum\":40,\"max\":20,"
+                      "\"p50\":20,\"p99\":20,\"buckets\":[[20,2]]},"
+                      "\"error_codes\":{\"5\":2}}"),
+            std::string::npos);
+  EXPECT_EQ(text.substr(text.size() - 3), "]}\n");
+}
+
+// 制御文字を含む呼び出し箇所名のエスケープをテスト
+TEST(MetricsExportTest, EscapeControlCharacters) {
+  LatencySite site("export\tcontrol\r\x01");
+  site.record(true, 1);
+
+  std::string prometheus;
+  format_metrics(MetricsFormat::Prometheus, prometheus);
+  EXPECT_NE(prometheus.find("t9_result_calls_total{site=\"export\\tcontrol"
+                            "\\r\\u0001\",outcome=\"ok\"} 1\n"),
+            std::string::npos);
+  EXPECT_EQ(prometheus.find('\t'), std::string::npos);
+
+  std::string json;
+  format_metrics(MetricsFormat::Json, json);
+  EXPECT_NE(json.find("{\"name\":\"export\\tcontrol\\r\\u0001\","),
+            std::string::npos);
+  EXPECT_EQ(json.find('\x01'), std::string::npos);
+}
+
+// ファイルへの書き出しをテスト
+TEST(MetricsExportTest, WriteFile) {
+  LatencySite site("export.file");
+  site.record(false, 7);
+  std::string path = temporary_path("metrics.prom");
+
+  ASSERT_TRUE(write_metrics_file(path, MetricsFormat::Prometheus).is_ok());
+  std::string text = read_file(path);
+  EXPECT_NE(text.find("t9_result_calls_total{site=\"export.file\","
+                      "outcome=\"err\"} 1\n"),
+            std::string::npos);
+  std::remove(path.c_str());
+
+  auto error = write_metrics_file("/nonexistent/dir/metrics",
+                                  MetricsFormat::Json);
+  ASSERT_TRUE(error.is_err());
+  EXPECT_STREQ(error.unwrap_err().m_operation, "open");
+  EXPECT_EQ(error.unwrap_err().m_errno, ENOENT);
+}
+
+// ソケット経由で記録中の値を取得できることをテスト
+TEST(MetricsExportTest, Socket) {
+  LatencySite site("export.socket");
+  std::string path = temporary_path("metrics.sock");
+
+  MetricsExporter exporter;
+  MetricsExporter::Options options;
+  options.m_socket_path = path;
+  ASSERT_TRUE(exporter.start(options).is_ok());
+
+  const std::string line =
+      "t9_result_calls_total{site=\"export.socket\",outcome=\"ok\"} ";
+  EXPECT_NE(scrape(path).find(line + "0\n"), std::string::npos);
+
+  // 記録を続けながら取得しても止まらないこと
+  std::thread producer([&site] {
+    for (int i = 0; i < 100000; ++i) {
+      site.record(true, 50);
+    }
+  });
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_NE(scrape(path).find(line), std::string::npos);
+  }
+  producer.join();
+  EXPECT_NE(scrape(path).find(line + "100000\n"), std::string::npos);
+
+  exporter.stop();
+  EXPECT_NE(::access(path.c_str(), F_OK), 0);
+}
+
+// 読み出さない接続があっても書き出しを打ち切って次の接続に応じるかテスト
+TEST(MetricsExportTest, SlowClient) {
+  // ソケットのバッファに収まらない量のメトリクスを用意する
+  std::vector<std::string> names(200);
+  std::vector<std::unique_ptr<LatencySite>> sites;
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    names[i] = "export.slow." + std::to_string(i);
+    sites.push_back(std::make_unique<LatencySite>(names[i].c_str()));
+  }
+  std::string path = temporary_path("slow.sock");
+
+  MetricsExporter exporter;
+  MetricsExporter::Options options;
+  options.m_socket_path = path;
+  options.m_send_timeout = std::chrono::milliseconds(50);
+  ASSERT_TRUE(exporter.start(options).is_ok());
+
+  int idle = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  std::strcpy(address.sun_path, path.c_str());
+  ASSERT_EQ(::connect(idle, reinterpret_cast<sockaddr*>(&address),
+                      sizeof(address)),
+            0);
+
+  std::string text = scrape(path);
+  EXPECT_NE(text.find("export.slow.199"), std::string::npos);
+  EXPECT_EQ(text.substr(text.size() - 2), "0\n");
+  ::close(idle);
+
+  // 書き出し中の接続があっても停止できる
+  idle = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  ASSERT_EQ(::connect(idle, reinterpret_cast<sockaddr*>(&address),
+                      sizeof(address)),
+            0);
+  auto start = std::chrono::steady_clock::now();
+  exporter.stop();
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+  ::close(idle);
+}
+
+// 定期的なファイルの更新をテスト
+TEST(MetricsExportTest, Periodic) {
+  LatencySite site("export.periodic");
+  std::string path = temporary_path("metrics.json");
+
+  MetricsExporter exporter;
+  MetricsExporter::Options options;
+  options.m_format = MetricsFormat::Json;
+  options.m_file_path = path;
+  options.m_interval = std::chrono::milliseconds(5);
+  ASSERT_TRUE(exporter.start(options).is_ok());
+
+  site.record(true, 1);
+  const std::string expected = "{\"name\":\"export.periodic\",\"ok\":"
+                               "{\"count\":1,";
+  bool found = false;
+  for (int i = 0; i < 400 && !found; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    found = read_file(path).find(expected) != std::string::npos;
+  }
+  EXPECT_TRUE(found);
+  exporter.stop();
+  std::remove(path.c_str());
+}
+
+// ソケットの準備の失敗をテスト
+TEST(MetricsExportTest, StartError) {
+  MetricsExporter exporter;
+  MetricsExporter::Options options;
+  options.m_socket_path = "/nonexistent/dir/metrics.sock";
+  auto error = exporter.start(options);
+  ASSERT_TRUE(error.is_err());
+  EXPECT_STREQ(error.unwrap_err().m_operation, "bind");
+}
+
+}  // namespace
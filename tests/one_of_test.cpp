@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <t9_result/one_of.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <variant>
+
+namespace {
+
+using namespace t9_result;
+
+enum class ParseError : std::uint8_t { Syntax = 1, Range };
+enum class IoError : std::uint8_t { NotFound = 1, Denied };
+struct DbError {
+  std::int32_t m_code;
+};
+
+// 判別子が1バイトであることをテスト
+TEST(OneOfTest, Size) {
+  static_assert(sizeof(OneOf<ParseError, IoError>) == 2);
+  static_assert(sizeof(OneOf<ParseError, IoError, DbError>) == 8);
+  static_assert(sizeof(OneOf<ParseError, IoError, DbError>) <=
+                sizeof(std::variant<ParseError, IoError, DbError>));
+  static_assert(sizeof(Result<int, OneOf<ParseError, IoError, DbError>>) <=
+                sizeof(Result<int,
+                              std::variant<ParseError, IoError, DbError>>));
+  SUCCEED();
+}
+
+// 生成と取り出しをテスト
+TEST(OneOfTest, Access) {
+  OneOf<ParseError, IoError, DbError> e = IoError::Denied;
+  EXPECT_EQ(e.index(), 1u);
+  EXPECT_TRUE(e.holds<IoError>());
+  EXPECT_FALSE(e.holds<ParseError>());
+  EXPECT_EQ(e.get<IoError>(), IoError::Denied);
+  EXPECT_EQ(e.get_if<DbError>(), nullptr);
+
+  e = DbError{42};
+  ASSERT_NE(e.get_if<DbError>(), nullptr);
+  EXPECT_EQ(e.get_if<DbError>()->m_code, 42);
+
+  struct Describe {
+    std::string operator()(ParseError) const {
+      return "parse";
+    }
+    std::string operator()(IoError) const {
+      return "io";
+    }
+    std::string operator()(const DbError& db) const {
+      return "db" + std::to_string(db.m_code);
+    }
+  };
+  EXPECT_EQ(e.visit(Describe{}), "db42");
+  const auto& ce = e;
+  EXPECT_EQ(ce.visit(Describe{}), "db42");
+}
+
+// 型の集合を広げる変換をテスト
+TEST(OneOfTest, Widen) {
+  OneOf<IoError, DbError> narrow = DbError{7};
+  OneOf<ParseError, IoError, DbError> wide = narrow;
+  EXPECT_EQ(wide.index(), 2u);
+  EXPECT_EQ(wide.get<DbError>().m_code, 7);
+
+  OneOf<ParseError, IoError, DbError> moved = std::move(narrow);
+  EXPECT_EQ(moved.get<DbError>().m_code, 7);
+
+  OneOf<std::string, int> s = std::string("message");
+  OneOf<double, int, std::string> ws = std::move(s);
+  EXPECT_EQ(ws.index(), 2u);
+  EXPECT_EQ(ws.get<std::string>(), "message");
+}
+
+// Err の変換コンストラクタが縮小変換を受け付けないことをテスト
+TEST(OneOfTest, ErrRejectsNarrowing) {
+  static_assert(std::is_constructible_v<Err<std::int64_t>, int>);
+  static_assert(!std::is_constructible_v<Err<std::int8_t>, int>);
+  static_assert(!std::is_constructible_v<Err<float>, double>);
+  static_assert(std::is_constructible_v<Err<OneOf<ParseError, IoError>>,
+                                        IoError>);
+  static_assert(std::is_constructible_v<Err<std::string>, const char*>);
+  // Result への変換も縮小変換であればオーバーロード解決で除外される
+  static_assert(!std::is_convertible_v<Err<int>, Result<int, std::int8_t>>);
+  static_assert(
+      !std::is_convertible_v<const Err<int>&, Result<void, std::int8_t>>);
+  static_assert(std::is_convertible_v<Err<int>, Result<int, std::int64_t>>);
+  Err<OneOf<ParseError, IoError>> err = IoError::Denied;
+  EXPECT_EQ(err.m_value.get<IoError>(), IoError::Denied);
+}
+
+// 非トリビアルな型の破棄をテスト
+TEST(OneOfTest, Lifetime) {
+  auto shared = std::make_shared<int>(1);
+  std::weak_ptr<int> watch = shared;
+  {
+    OneOf<int, std::shared_ptr<int>> e = std::move(shared);
+    OneOf<int, std::shared_ptr<int>> copy = e;
+    e = 3;
+    EXPECT_FALSE(watch.expired());
+    copy = OneOf<int, std::shared_ptr<int>>(4);
+    EXPECT_TRUE(watch.expired());
+  }
+}
+
+Result<int, ParseError> parse(int input) {
+  if (input < 0) {
+    return make_err(ParseError::Range);
+  }
+  return make_ok(input);
+}
+
+Result<int, OneOf<ParseError, IoError>> read(int input) {
+  return parse(input).and_then(
+      [](int value) -> Result<int, OneOf<ParseError, IoError>> {
+        if (value == 0) {
+          return make_err(IoError::NotFound);
+        }
+        return make_ok(value);
+      });
+}
+
+Result<int, OneOf<ParseError, IoError, DbError>> store(int input) {
+  Result<int, OneOf<ParseError, IoError, DbError>> r = read(input);
+  if (r.is_ok() && r.ref_ok() > 100) {
+    return make_err(DbError{r.ref_ok()});
+  }
+  return r;
+}
+
+// Result の失敗値の変換をテスト
+TEST(OneOfTest, ResultPropagation) {
+  EXPECT_EQ(store(5).unwrap(), 5);
+  EXPECT_EQ(store(-1).unwrap_err().get<ParseError>(), ParseError::Range);
+  EXPECT_EQ(store(0).unwrap_err().get<IoError>(), IoError::NotFound);
+  EXPECT_EQ(store(101).unwrap_err().get<DbError>().m_code, 101);
+
+  Result<void, IoError> io = make_err(IoError::Denied);
+  Result<void, OneOf<ParseError, IoError>> widened = std::move(io);
+  EXPECT_TRUE(widened.unwrap_err().holds<IoError>());
+}
+
+}  // namespace
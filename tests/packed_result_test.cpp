@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <t9_result/packed_result.h>
+
+#include <cstdint>
+
+namespace {
+
+using namespace t9_result;
+
+enum class Reason : std::uint8_t {
+  TooShort,
+  TooLong,
+  BadChar = 100,
+};
+
+// 基底型が int の列挙型
+enum class Status {
+  Ready,
+  Busy,
+  Broken = 100,
+};
+
+enum class Level : std::int8_t {
+  Low = -3,
+  High = 3,
+};
+
+}  // namespace
+
+template <>
+struct t9_result::BitWidth<Reason> {
+  static constexpr unsigned value = 7;
+};
+
+template <>
+struct t9_result::BitWidth<Status> {
+  static constexpr unsigned value = 7;
+};
+
+template <>
+struct t9_result::BitWidth<Level> {
+  static constexpr unsigned value = 3;
+  static constexpr bool is_signed = true;
+};
+
+namespace {
+
+// 格納先の大きさをテスト
+TEST(PackedResultTest, Size) {
+  static_assert(PackedResult<bool, Reason>::kBits == 8);
+  static_assert(sizeof(PackedResult<bool, Reason>) == 1);
+  static_assert(sizeof(PackedResult<void, Level>) == 1);
+  static_assert(sizeof(PackedResult<std::uint8_t, Reason>) == 2);
+  static_assert(sizeof(PackedResult<std::uint32_t, Reason>) == 8);
+  static_assert(sizeof(PackedResult<std::int32_t, bool>) == 8);
+  static_assert(std::is_trivially_copyable_v<PackedResult<bool, Reason>>);
+}
+
+// 成功値・失敗値の格納と取り出しをテスト
+TEST(PackedResultTest, OkErr) {
+  using Packed = PackedResult<bool, Reason>;
+
+  Packed ok = make_ok(true);
+  EXPECT_TRUE(ok.is_ok());
+  EXPECT_FALSE(ok.is_err());
+  EXPECT_TRUE(ok.unwrap());
+  EXPECT_TRUE(ok.unwrap_or(false));
+
+  Packed ok_false = make_ok(false);
+  EXPECT_TRUE(ok_false.is_ok());
+  EXPECT_FALSE(ok_false.unwrap());
+
+  Packed err = make_err(Reason::BadChar);
+  EXPECT_TRUE(err.is_err());
+  EXPECT_EQ(err.unwrap_err(), Reason::BadChar);
+  EXPECT_TRUE(err.unwrap_or(true));
+
+  Packed err0 = make_err(Reason::TooShort);
+  EXPECT_TRUE(err0.is_err());
+  EXPECT_EQ(err0.unwrap_err(), Reason::TooShort);
+
+  EXPECT_EQ(ok, Packed(make_ok(true)));
+  EXPECT_NE(ok, ok_false);
+  EXPECT_NE(err, err0);
+  EXPECT_EQ(Packed::from_raw(err.raw()), err);
+}
+
+// 符号付きの値とvoidの成功値をテスト
+TEST(PackedResultTest, Signed) {
+  using Packed = PackedResult<std::int16_t, Level>;
+  Packed low = make_err(Level::Low);
+  EXPECT_EQ(low.unwrap_err(), Level::Low);
+  Packed high = make_err(Level::High);
+  EXPECT_EQ(high.unwrap_err(), Level::High);
+  Packed negative = make_ok(std::int16_t{-12345});
+  EXPECT_EQ(negative.unwrap(), -12345);
+
+  PackedResult<void, Level> unit = make_ok();
+  EXPECT_TRUE(unit.is_ok());
+  PackedResult<void, Level> failed = make_err(Level::Low);
+  EXPECT_EQ(failed.unwrap_err(), Level::Low);
+}
+
+// 基底型が符号付きの列挙型も符号なしとして格納されるかテスト
+TEST(PackedResultTest, SignedUnderlyingEnum) {
+  using Packed = PackedResult<bool, Status>;
+  static_assert(sizeof(Packed) == 1);
+  Packed broken = make_err(Status::Broken);
+  EXPECT_EQ(broken.unwrap_err(), Status::Broken);
+  EXPECT_EQ(Packed(make_err(Status::Busy)).unwrap_err(), Status::Busy);
+  EXPECT_EQ(Packed::from_raw(broken.raw()), broken);
+}
+
+// Result との相互変換をテスト
+TEST(PackedResultTest, Convert) {
+  using Packed = PackedResult<std::uint32_t, Reason>;
+  Result<std::uint32_t, Reason> ok = make_ok(std::uint32_t{0xFFFFFFFF});
+  Packed packed_ok(ok);
+  EXPECT_EQ(packed_ok.unwrap(), 0xFFFFFFFFu);
+  EXPECT_EQ(packed_ok.to_result().unwrap(), 0xFFFFFFFFu);
+
+  Result<std::uint32_t, Reason> err = make_err(Reason::TooLong);
+  Packed packed_err(err);
+  EXPECT_EQ(packed_err.to_result().unwrap_err(), Reason::TooLong);
+
+  Result<void, Level> unit = PackedResult<void, Level>(make_ok()).to_result();
+  EXPECT_TRUE(unit.is_ok());
+}
+
+// 定数式での使用をテスト
+TEST(PackedResultTest, Constexpr) {
+  using Packed = PackedResult<bool, Reason>;
+  constexpr Packed err = Packed::from_raw(1 << 1);
+  static_assert(err.is_err());
+  static_assert(err.unwrap_err() == Reason::TooLong);
+  constexpr Packed ok = Packed::from_raw(0b11);
+  static_assert(ok.is_ok() && ok.unwrap());
+}
+
+}  // namespace
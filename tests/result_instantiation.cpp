@@ -0,0 +1,5 @@
+// T9_RESULT_EXTERN_TEMPLATE で宣言した組み合わせを明示的にインスタンス化する
+#include <t9_result/prelude.h>
+
+T9_RESULT_INSTANTIATE_TEMPLATE(int, int);
+T9_RESULT_INSTANTIATE_TEMPLATE(void, int);
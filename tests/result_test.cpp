@@ -2,8 +2,13 @@
 #include <t9_result/prelude.h>
 
 #include <cstddef>
+#include <type_traits>
 #include <utility>
 
+// result_instantiation.cpp で明示的にインスタンス化する
+T9_RESULT_EXTERN_TEMPLATE(int, int);
+T9_RESULT_EXTERN_TEMPLATE(void, int);
+
 namespace {
 
 using namespace t9_result;
@@ -77,6 +82,26 @@ TEST(ResultTest, MakeErr) {
   }
 }
 
+// 検査なしアクセサの動作をテスト
+TEST(ResultTest, Unchecked) {
+  {
+    Result<int, int> result = make_ok(42);
+    EXPECT_EQ(result.unchecked_ok(), 42);
+    result.unchecked_ok() = 43;
+    EXPECT_EQ(std::as_const(result).unchecked_ok(), 43);
+  }
+  {
+    Result<int, int> result = make_err(42);
+    EXPECT_EQ(result.unchecked_err(), 42);
+    result.unchecked_err() = 43;
+    EXPECT_EQ(std::as_const(result).unchecked_err(), 43);
+  }
+  {
+    Result<void, int> result = make_err(42);
+    EXPECT_EQ(result.unchecked_err(), 42);
+  }
+}
+
 // 成功値と失敗値の場合のunwrap_orの動作をテスト
 TEST(ResultTest, UnwrapOr) {
   {
@@ -202,6 +227,84 @@ TEST(ResultTest, AndThen) {
   }
 }
 
+// 成功値と失敗値に対するmatch関数の動作をテスト
+TEST(ResultTest, Match) {
+  {
+    Result<int, int> result = make_ok(42);
+    auto value = result.match([](int x) { return x * 2; },
+                              [](int x) { return -x; });
+    EXPECT_EQ(value, 84);
+  }
+  {
+    Result<int, int> result = make_err(42);
+    auto value = result.match([](int x) { return x * 2; },
+                              [](int x) { return -x; });
+    EXPECT_EQ(value, -42);
+  }
+  {
+    // 戻り値型が異なる場合は共通型に変換される
+    Result<int, int> result = make_ok(42);
+    auto value = result.match([](int x) { return x; },
+                              [](int) { return 0.5; });
+    static_assert(std::is_same_v<decltype(value), double>);
+    EXPECT_EQ(value, 42.0);
+  }
+}
+
+// match関数が値カテゴリを保って値を渡すことをテスト
+TEST(ResultTest, MatchValueCategory) {
+  {
+    Result<int, int> result = make_ok(42);
+    result.match([](int& x) { x = 43; }, [](int&) {});
+    EXPECT_EQ(result.ref_ok(), 43);
+  }
+  {
+    const Result<int, int> result = make_err(42);
+    auto value = result.match([](const int& x) { return x; },
+                              [](const int& x) { return x + 1; });
+    EXPECT_EQ(value, 43);
+  }
+  {
+    Result<NoncopyableObject, int> result = make_ok_with<NoncopyableObject>(42);
+    auto object = std::move(result).match(
+        [](NoncopyableObject&& x) { return NoncopyableObject(std::move(x)); },
+        [](int&& x) { return NoncopyableObject(x); });
+    EXPECT_EQ(object.id(), 42);
+    EXPECT_EQ(result.ref_ok().id(), 0) << "NoncopyableObject should be moved";
+  }
+}
+
+// 参照型のResultの動作をテスト
+TEST(ResultTest, ReferenceResult) {
+  int value = 42;
+  int other = 43;
+  {
+    Result<int&, int> result = make_ok_ref(value);
+    EXPECT_TRUE(result.is_ok());
+    EXPECT_EQ(&result.ref_ok(), &value);
+    result.ref_ok() = 44;
+    EXPECT_EQ(value, 44);
+    EXPECT_EQ(&result.unwrap(), &value);
+  }
+  {
+    Result<int&, int> result = make_err(1);
+    EXPECT_EQ(&result.unwrap_or(other), &other);
+  }
+  {
+    Result<int&, int> result = make_ok_ref(value);
+    auto mapped = result.map_err([](int x) { return x * 2; });
+    EXPECT_EQ(&mapped.ref_ok(), &value);
+    auto doubled = mapped.map([](int& x) { return x * 2; });
+    EXPECT_EQ(doubled.unwrap(), 88);
+  }
+  {
+    Result<int&, int> result = make_ok_ref(value);
+    int* p = std::move(result).match([](int& x) { return &x; },
+                                     [](int) -> int* { return nullptr; });
+    EXPECT_EQ(p, &value);
+  }
+}
+
 // void型のResultの基本的な動作をテスト
 TEST(ResultTest, VoidResult) {
   {
@@ -345,4 +448,18 @@ TEST(ResultTest, VoidResultAndThen) {
   }
 }
 
+// void型のResultに対するmatch関数の動作をテスト
+TEST(ResultTest, VoidResultMatch) {
+  {
+    Result<void, int> result = make_ok();
+    auto value = result.match([]() { return 1; }, [](int x) { return x; });
+    EXPECT_EQ(value, 1);
+  }
+  {
+    Result<void, int> result = make_err(42);
+    auto value = result.match([]() { return 1; }, [](int x) { return x; });
+    EXPECT_EQ(value, 42);
+  }
+}
+
 }  // namespace
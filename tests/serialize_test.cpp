@@ -0,0 +1,313 @@
+#include <gtest/gtest.h>
+#include <t9_result/serialize.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+struct Point {
+  std::int32_t x;
+  std::int32_t y;
+};
+
+enum class Level : std::uint8_t {
+  Low = 1,
+  High = 2,
+};
+
+// 下位3バイトのみをエンコードする値（sizeof と異なる固定長）
+struct Uint24 {
+  std::uint32_t value;
+};
+
+// 1バイトに収まる値のみエンコードできる値
+struct Small {
+  std::uint32_t value;
+};
+
+}  // namespace
+
+namespace t9_result {
+
+template <>
+struct AnyBitPattern<Point> : std::true_type {};
+
+template <>
+struct Codec<Uint24> {
+  static constexpr bool is_fixed_size = true;
+  static constexpr std::size_t fixed_size = 3;
+
+  static constexpr std::size_t encoded_size(const Uint24&) {
+    return fixed_size;
+  }
+
+  static void encode(const Uint24& value, std::byte* out) {
+    for (std::size_t i = 0; i < fixed_size; ++i) {
+      out[i] = static_cast<std::byte>(value.value >> (8 * i));
+    }
+  }
+
+  static Result<Uint24, WireError> decode(const std::byte* data,
+                                          std::size_t size,
+                                          std::size_t& consumed) {
+    if (size < fixed_size) {
+      return make_err(WireError::Truncated);
+    }
+    Uint24 value{0};
+    for (std::size_t i = 0; i < fixed_size; ++i) {
+      value.value |= std::to_integer<std::uint32_t>(data[i]) << (8 * i);
+    }
+    consumed = fixed_size;
+    return make_ok(value);
+  }
+};
+
+template <>
+struct Codec<Small> {
+  static constexpr bool is_fixed_size = true;
+  static constexpr std::size_t fixed_size = 1;
+
+  static constexpr std::size_t encoded_size(const Small&) {
+    return fixed_size;
+  }
+
+  static Result<void, WireError> encode(const Small& value, std::byte* out) {
+    if (value.value > 0xff) {
+      return make_err(WireError::InvalidPayload);
+    }
+    out[0] = static_cast<std::byte>(value.value);
+    return make_ok();
+  }
+
+  static Result<Small, WireError> decode(const std::byte* data,
+                                         std::size_t size,
+                                         std::size_t& consumed) {
+    if (size < fixed_size) {
+      return make_err(WireError::Truncated);
+    }
+    consumed = fixed_size;
+    return make_ok(Small{std::to_integer<std::uint32_t>(data[0])});
+  }
+};
+
+}  // namespace t9_result
+
+namespace {
+
+using namespace t9_result;
+
+template <typename T, typename E>
+std::vector<std::byte> encode_to_vector(const Result<T, E>& result) {
+  std::vector<std::byte> buffer(encoded_size(result));
+  auto written = encode(result, buffer.data(), buffer.size());
+  EXPECT_TRUE(written.is_ok());
+  EXPECT_EQ(written.unwrap(), buffer.size());
+  return buffer;
+}
+
+// トリビアルコピー可能な型のエンコードとデコードをテスト
+TEST(SerializeTest, RoundTripTrivial) {
+  {
+    Result<Point, int> result = make_ok(Point{1, 2});
+    auto buffer = encode_to_vector(result);
+    EXPECT_EQ(buffer.size(), 1 + sizeof(Point));
+    EXPECT_EQ(buffer[0], static_cast<std::byte>(WireTag::Ok));
+
+    auto decoded = decode<Point, int>(buffer.data(), buffer.size()).unwrap();
+    EXPECT_TRUE(decoded.is_ok());
+    EXPECT_EQ(decoded.ref_ok().x, 1);
+    EXPECT_EQ(decoded.ref_ok().y, 2);
+  }
+  {
+    Result<Point, int> result = make_err(42);
+    auto buffer = encode_to_vector(result);
+    EXPECT_EQ(buffer.size(), 1 + sizeof(int));
+    EXPECT_EQ(buffer[0], static_cast<std::byte>(WireTag::Err));
+
+    auto decoded = decode<Point, int>(buffer.data(), buffer.size()).unwrap();
+    EXPECT_TRUE(decoded.is_err());
+    EXPECT_EQ(decoded.ref_err(), 42);
+  }
+  {
+    Result<void, int> result = make_ok();
+    auto buffer = encode_to_vector(result);
+    EXPECT_EQ(buffer.size(), 1u);
+
+    auto decoded = decode<void, int>(buffer.data(), buffer.size()).unwrap();
+    EXPECT_TRUE(decoded.is_ok());
+  }
+}
+
+// 可変長の型のエンコードとデコードをテスト
+TEST(SerializeTest, RoundTripString) {
+  Result<int, std::string> result = make_err(std::string("not found"));
+  auto buffer = encode_to_vector(result);
+
+  std::size_t consumed = 0;
+  auto decoded =
+      decode<int, std::string>(buffer.data(), buffer.size(), consumed).unwrap();
+  EXPECT_EQ(consumed, buffer.size());
+  EXPECT_EQ(decoded.ref_err(), "not found");
+}
+
+// 不正な入力に対するエラーをテスト
+TEST(SerializeTest, Errors) {
+  Result<Point, int> result = make_ok(Point{1, 2});
+  std::byte small[4];
+  EXPECT_EQ(encode(result, small, sizeof(small)).unwrap_err(),
+            WireError::BufferTooSmall);
+
+  auto buffer = encode_to_vector(result);
+  EXPECT_EQ((decode<Point, int>(buffer.data(), 0).unwrap_err()),
+            WireError::Truncated);
+  EXPECT_EQ((decode<Point, int>(buffer.data(), buffer.size() - 1)
+                 .unwrap_err()),
+            WireError::Truncated);
+
+  buffer[0] = std::byte{0x7f};
+  EXPECT_EQ((decode<Point, int>(buffer.data(), buffer.size()).unwrap_err()),
+            WireError::InvalidTag);
+  EXPECT_EQ((ResultView<Point, int>::from_bytes(buffer.data(), buffer.size())
+                 .unwrap_err()),
+            WireError::InvalidTag);
+}
+
+// デシリアライズしないビューの動作をテスト
+TEST(SerializeTest, View) {
+  Result<Point, std::uint16_t> result = make_ok(Point{3, 4});
+  auto buffer = encode_to_vector(result);
+
+  auto view =
+      ResultView<Point, std::uint16_t>::from_bytes(buffer.data(), buffer.size())
+          .unwrap();
+  EXPECT_TRUE(view.is_ok());
+  EXPECT_FALSE(view.is_err());
+  EXPECT_EQ(view.payload(), buffer.data() + 1);
+  EXPECT_EQ(view.load_ok().unwrap().y, 4);
+
+  buffer.pop_back();
+  EXPECT_EQ((ResultView<Point, std::uint16_t>::from_bytes(buffer.data(),
+                                                          buffer.size())
+                 .unwrap_err()),
+            WireError::Truncated);
+}
+
+// 不正なビット列を持ちうる型の扱いをテスト
+TEST(SerializeTest, InvalidBitPatterns) {
+  static_assert(!AnyBitPattern<bool>::value);
+  static_assert(!AnyBitPattern<int*>::value);
+  static_assert(AnyBitPattern<Level>::value);
+
+  Result<bool, Level> result = make_ok(true);
+  auto buffer = encode_to_vector(result);
+  EXPECT_EQ(buffer.size(), 2u);
+  EXPECT_TRUE((decode<bool, Level>(buffer.data(), buffer.size())
+                   .unwrap()
+                   .ref_ok()));
+
+  // bool は0と1以外を受け付けない
+  buffer[1] = std::byte{2};
+  EXPECT_EQ((decode<bool, Level>(buffer.data(), buffer.size()).unwrap_err()),
+            WireError::InvalidPayload);
+  auto view =
+      ResultView<bool, Level>::from_bytes(buffer.data(), buffer.size());
+  EXPECT_EQ(view.unwrap().load_ok().unwrap_err(), WireError::InvalidPayload);
+
+  // スコープ付き列挙型は基底型の任意の値を保持できる
+  buffer[0] = static_cast<std::byte>(WireTag::Err);
+  buffer[1] = std::byte{200};
+  auto decoded = decode<bool, Level>(buffer.data(), buffer.size()).unwrap();
+  EXPECT_EQ(static_cast<int>(decoded.ref_err()), 200);
+}
+
+// 固定長のスロットが Codec のバイト数で決まることをテスト
+TEST(SerializeTest, FixedSizeFromCodec) {
+  static_assert(max_encoded_size<Uint24, bool>() == 4);
+  static_assert(max_encoded_size<void, Uint24>() == 4);
+
+  Result<Uint24, bool> result = make_ok(Uint24{0x123456});
+  auto buffer = encode_to_vector(result);
+  EXPECT_EQ(buffer.size(), 4u);
+  auto view =
+      ResultView<Uint24, bool>::from_bytes(buffer.data(), buffer.size())
+          .unwrap();
+  EXPECT_EQ(view.load_ok().unwrap().value, 0x123456u);
+
+  buffer.pop_back();
+  EXPECT_EQ((ResultView<Uint24, bool>::from_bytes(buffer.data(),
+                                                  buffer.size())
+                 .unwrap_err()),
+            WireError::Truncated);
+}
+
+// エンコードできない値は何も書き込まずにエラーになることをテスト
+TEST(SerializeTest, EncodeRejectsInvalidPayload) {
+  Result<Small, int> ok = make_ok(Small{0x12});
+  auto buffer = encode_to_vector(ok);
+  EXPECT_EQ(buffer[1], std::byte{0x12});
+
+  std::byte out[2] = {std::byte{0xaa}, std::byte{0xaa}};
+  Result<Small, int> too_large = make_ok(Small{0x100});
+  EXPECT_EQ(encode(too_large, out, sizeof(out)).unwrap_err(),
+            WireError::InvalidPayload);
+  EXPECT_EQ(out[0], std::byte{0xaa});
+  EXPECT_EQ(out[1], std::byte{0xaa});
+
+  Result<void, Small> err = make_err(Small{0x100});
+  EXPECT_EQ(encode(err, out, sizeof(out)).unwrap_err(),
+            WireError::InvalidPayload);
+  EXPECT_EQ(out[0], std::byte{0xaa});
+}
+
+// ランダムな値の往復変換をテスト
+TEST(SerializeTest, FuzzRoundTrip) {
+  std::mt19937_64 rng(12345);
+  for (int i = 0; i < 10000; ++i) {
+    std::uint64_t value = rng();
+    std::string text(rng() % 64, static_cast<char>('a' + rng() % 26));
+    Result<std::uint64_t, std::string> result =
+        (value & 1) ? Result<std::uint64_t, std::string>(make_ok(value))
+                    : Result<std::uint64_t, std::string>(make_err(text));
+    auto buffer = encode_to_vector(result);
+
+    auto decoded =
+        decode<std::uint64_t, std::string>(buffer.data(), buffer.size());
+    ASSERT_TRUE(decoded.is_ok());
+    auto& r = decoded.ref_ok();
+    ASSERT_EQ(r.is_ok(), result.is_ok());
+    if (r.is_ok()) {
+      ASSERT_EQ(r.ref_ok(), value);
+    } else {
+      ASSERT_EQ(r.ref_err(), text);
+    }
+  }
+}
+
+// ランダムなバイト列のデコードが範囲外を読まないことをテスト
+TEST(SerializeTest, FuzzDecode) {
+  std::mt19937 rng(54321);
+  for (int i = 0; i < 10000; ++i) {
+    std::vector<std::byte> buffer(rng() % 16);
+    for (auto& b : buffer) {
+      b = static_cast<std::byte>(rng() % 4);
+    }
+    std::size_t consumed = 0;
+    auto decoded = decode<std::uint32_t, std::string>(buffer.data(),
+                                                      buffer.size(), consumed);
+    if (decoded.is_ok()) {
+      ASSERT_LE(consumed, buffer.size());
+      // デコードできた場合は再エンコードで同じバイト列に戻る
+      auto encoded = encode_to_vector(decoded.ref_ok());
+      ASSERT_EQ(encoded.size(), consumed);
+      ASSERT_TRUE(std::equal(encoded.begin(), encoded.end(), buffer.begin()));
+    }
+  }
+}
+
+}  // namespace
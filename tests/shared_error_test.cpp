@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <t9_result/shared_error.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+
+// 生成とコピーをテスト
+TEST(SharedErrorTest, Copy) {
+  SharedError error = SharedError::make(404, "not found");
+  EXPECT_EQ(error.code(), 404);
+  EXPECT_EQ(error.message(), "not found");
+  EXPECT_EQ(error.use_count(), 1u);
+  {
+    SharedError copy = error;
+    EXPECT_EQ(error.use_count(), 2u);
+    EXPECT_EQ(copy.message().data(), error.message().data());
+    SharedError moved = std::move(copy);
+    EXPECT_EQ(error.use_count(), 2u);
+    EXPECT_EQ(moved.code(), 404);
+  }
+  EXPECT_EQ(error.use_count(), 1u);
+
+  SharedError other = SharedError::make(500, "internal");
+  other = error;
+  EXPECT_EQ(other.code(), 404);
+  EXPECT_EQ(error.use_count(), 2u);
+}
+
+// 文脈の追加をテスト
+TEST(SharedErrorTest, Context) {
+  LocalSharedError root = LocalSharedError::make(2, "no such file");
+  LocalSharedError outer = root.context("reading config").context("startup");
+  EXPECT_EQ(outer.code(), 2);
+  EXPECT_EQ(outer.message(), "startup");
+  EXPECT_EQ(outer.to_string(), "startup: reading config: no such file");
+  EXPECT_EQ(root.to_string(), "no such file");
+  EXPECT_EQ(root.use_count(), 2u);
+
+  std::vector<std::string> messages;
+  outer.for_each_message(
+      [&](std::string_view message) { messages.emplace_back(message); });
+  ASSERT_EQ(messages.size(), 3u);
+  EXPECT_EQ(messages[1], "reading config");
+}
+
+Result<int, SharedError> read_config(bool found) {
+  if (!found) {
+    return make_err(SharedError::make(2, "no such file"));
+  }
+  return make_ok(7);
+}
+
+// Result の失敗値としての使用をテスト
+TEST(SharedErrorTest, Result) {
+  auto failed = read_config(false).map_err(with_context("loading"));
+  ASSERT_TRUE(failed.is_err());
+  EXPECT_EQ(failed.ref_err().to_string(), "loading: no such file");
+
+  Result<int, SharedError> copy = failed;
+  EXPECT_EQ(failed.ref_err().use_count(), 2u);
+  EXPECT_EQ(copy.ref_err().message().data(),
+            failed.ref_err().message().data());
+
+  EXPECT_EQ(read_config(true).map_err(with_context("loading")).unwrap(), 7);
+}
+
+// 長い原因の連鎖の解放をテスト
+TEST(SharedErrorTest, LongChain) {
+  SharedError error = SharedError::make(1, "root");
+  for (int i = 0; i < 100000; ++i) {
+    error = error.context("frame");
+  }
+  EXPECT_EQ(error.code(), 1);
+  EXPECT_EQ(error.message(), "frame");
+}
+
+// 複数スレッドからのコピーと破棄をテスト
+TEST(SharedErrorTest, Threads) {
+  SharedError error = SharedError::make(503, "unavailable");
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([error] {
+      for (int i = 0; i < 10000; ++i) {
+        SharedError copy = error;
+        SharedError wrapped = copy.context("retry");
+        EXPECT_EQ(wrapped.code(), 503);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(error.use_count(), 1u);
+}
+
+}  // namespace
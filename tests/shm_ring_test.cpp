@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <t9_result/shm_ring.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+
+namespace {
+
+using namespace t9_result;
+
+using Ring = ShmResultRing<std::uint64_t, std::int32_t, 8>;
+
+// 単一プロセス内での書き込みと読み出しをテスト
+TEST(ShmRingTest, PushPop) {
+  auto ring = Ring::create().unwrap();
+
+  EXPECT_EQ(ring.try_pop().unwrap_err(), RingError::Empty);
+
+  EXPECT_TRUE(ring.try_push(make_ok(std::uint64_t{42})).is_ok());
+  EXPECT_TRUE(ring.try_push(make_err(std::int32_t{-1})).is_ok());
+
+  auto first = ring.try_pop().unwrap();
+  EXPECT_TRUE(first.is_ok());
+  EXPECT_EQ(first.unwrap(), 42u);
+
+  auto second = ring.pop();
+  EXPECT_TRUE(second.is_err());
+  EXPECT_EQ(second.unwrap_err(), -1);
+
+  EXPECT_EQ(ring.try_pop().unwrap_err(), RingError::Empty);
+}
+
+// 満杯時の動作とインデックスの周回をテスト
+TEST(ShmRingTest, Full) {
+  auto ring = Ring::create().unwrap();
+  for (int round = 0; round < 3; ++round) {
+    for (std::uint64_t i = 0; i < 8; ++i) {
+      EXPECT_TRUE(ring.try_push(make_ok(i)).is_ok());
+    }
+    EXPECT_EQ(ring.try_push(make_ok(std::uint64_t{8})).unwrap_err(),
+              RingError::Full);
+    for (std::uint64_t i = 0; i < 8; ++i) {
+      EXPECT_EQ(ring.pop().unwrap(), i);
+    }
+  }
+}
+
+// 期限付きの読み出しをテスト
+TEST(ShmRingTest, PopDeadline) {
+  auto ring = Ring::create().unwrap();
+
+  auto start = std::chrono::steady_clock::now();
+  auto timed_out = ring.pop(Deadline::after(std::chrono::milliseconds(20)));
+  EXPECT_TRUE(timed_out.is_err());
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(20));
+
+  EXPECT_TRUE(ring.try_push(make_ok(std::uint64_t{7})).is_ok());
+  auto popped = ring.pop(Deadline::after(std::chrono::milliseconds(20)));
+  EXPECT_EQ(popped.unwrap().unwrap(), 7u);
+
+  // 期限切れでも読み出せる値があれば返す
+  EXPECT_TRUE(ring.try_push(make_ok(std::uint64_t{8})).is_ok());
+  auto expired = ring.pop(Deadline(std::chrono::steady_clock::now()));
+  EXPECT_EQ(expired.unwrap().unwrap(), 8u);
+}
+
+// fork した子プロセスとの受け渡しをテスト
+TEST(ShmRingTest, CrossProcess) {
+  constexpr std::uint64_t kCount = 10000;
+  auto ring = Ring::create().unwrap();
+
+  pid_t pid = ::fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    auto child = Ring::attach(::dup(ring.fd())).unwrap();
+    for (std::uint64_t i = 0; i < kCount; ++i) {
+      if (i % 10 == 0) {
+        child.push(make_err(static_cast<std::int32_t>(i)));
+      } else {
+        child.push(make_ok(i));
+      }
+    }
+    ::_exit(0);
+  }
+
+  bool ordered = true;
+  for (std::uint64_t i = 0; i < kCount; ++i) {
+    auto result = ring.pop();
+    if (i % 10 == 0) {
+      ordered &= result.is_err() &&
+                 result.unwrap_err() == static_cast<std::int32_t>(i);
+    } else {
+      ordered &= result.is_ok() && result.unwrap() == i;
+    }
+  }
+  EXPECT_TRUE(ordered);
+
+  int status = 0;
+  ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+}  // namespace
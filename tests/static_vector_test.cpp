@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <t9_result/static_string.h>
+#include <t9_result/static_vector.h>
+
+#include <memory>
+#include <string>
+
+namespace {
+
+using namespace t9_result;
+
+// 要素の追加と容量超過をテスト
+TEST(StaticVectorTest, PushBack) {
+  StaticVector<int, 3> v;
+  EXPECT_TRUE(v.empty());
+  EXPECT_EQ(v.capacity(), 3u);
+
+  auto& first = v.try_push_back(1).unwrap();
+  EXPECT_EQ(&first, &v[0]);
+  first = 10;
+  EXPECT_EQ(v[0], 10);
+
+  EXPECT_TRUE(v.try_push_back(2).is_ok());
+  EXPECT_TRUE(v.try_emplace_back(3).is_ok());
+
+  auto full = v.try_push_back(4);
+  ASSERT_TRUE(full.is_err());
+  EXPECT_EQ(full.ref_err().m_capacity, 3u);
+  EXPECT_EQ(full.ref_err().m_requested, 4u);
+  EXPECT_EQ(v.size(), 3u);
+
+  v.pop_back();
+  EXPECT_EQ(v.size(), 2u);
+  EXPECT_TRUE(v.try_push_back(5).is_ok());
+  EXPECT_EQ(v[2], 5);
+}
+
+// 途中への挿入をテスト
+TEST(StaticVectorTest, Insert) {
+  StaticVector<std::string, 4> v;
+  v.try_push_back("a").unwrap();
+  v.try_push_back("c").unwrap();
+
+  EXPECT_EQ(v.try_insert(1, "b").unwrap(), "b");
+  EXPECT_EQ(v.try_insert(0, "_").unwrap(), "_");
+  EXPECT_TRUE(v.try_insert(0, "x").is_err());
+
+  std::string joined;
+  for (const auto& s : v) {
+    joined += s;
+  }
+  EXPECT_EQ(joined, "_abc");
+}
+
+// 非トリビアルな要素のコピー・ムーブ・破棄をテスト
+TEST(StaticVectorTest, NonTrivialElements) {
+  auto counter = std::make_shared<int>(0);
+  {
+    StaticVector<std::shared_ptr<int>, 4> v;
+    v.try_push_back(counter).unwrap();
+    v.try_push_back(counter).unwrap();
+    EXPECT_EQ(counter.use_count(), 3);
+
+    auto copied = v;
+    EXPECT_EQ(counter.use_count(), 5);
+
+    auto moved = std::move(copied);
+    EXPECT_EQ(counter.use_count(), 5);
+
+    moved.clear();
+    EXPECT_EQ(counter.use_count(), 3);
+  }
+  EXPECT_EQ(counter.use_count(), 1);
+}
+
+// 固定容量の文字列の追加と容量超過をテスト
+TEST(StaticStringTest, Append) {
+  StaticString<8> s;
+  EXPECT_TRUE(s.try_append("hello").is_ok());
+  EXPECT_TRUE(s.try_push_back(',').is_ok());
+  EXPECT_EQ(s.view(), "hello,");
+
+  auto overflow = s.try_append("world");
+  ASSERT_TRUE(overflow.is_err());
+  EXPECT_EQ(overflow.ref_err().m_requested, 11u);
+  EXPECT_STREQ(s.c_str(), "hello,") << "string should not be modified";
+
+  EXPECT_TRUE(s.try_append("ok").is_ok());
+  EXPECT_EQ(s.size(), 8u);
+  EXPECT_TRUE(s.try_push_back('!').is_err());
+
+  EXPECT_TRUE(StaticString<4>::from("abcd").is_ok());
+  EXPECT_TRUE(StaticString<4>::from("abcde").is_err());
+}
+
+}  // namespace
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <t9_result/timer_wheel.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace t9_result;
+using namespace std::chrono_literals;
+
+// 期限の順に発火するかテスト
+TEST(TimerWheelTest, FiresInOrder) {
+  TimerWheel wheel;
+  std::vector<int> fired;
+  wheel.schedule_at(3, [&fired] { fired.push_back(3); });
+  wheel.schedule_at(1, [&fired] { fired.push_back(1); });
+  wheel.schedule_at(200, [&fired] { fired.push_back(200); });
+  wheel.schedule_at(64, [&fired] { fired.push_back(64); });
+  EXPECT_EQ(wheel.size(), 4u);
+
+  EXPECT_EQ(wheel.advance_to(0), 0u);
+  EXPECT_EQ(wheel.advance_to(3), 2u);
+  EXPECT_EQ(fired, (std::vector<int>{1, 3}));
+  EXPECT_EQ(wheel.current_tick(), 4u);
+  EXPECT_EQ(wheel.advance_to(199), 1u);
+  EXPECT_EQ(wheel.advance_to(200), 1u);
+  EXPECT_EQ(fired, (std::vector<int>{1, 3, 64, 200}));
+  EXPECT_TRUE(wheel.empty());
+
+  // 処理済みのティックは次のティックで発火する
+  wheel.schedule_at(5, [&fired] { fired.push_back(5); });
+  EXPECT_EQ(wheel.advance_to(201), 1u);
+}
+
+// キャンセルと識別子の再利用をテスト
+TEST(TimerWheelTest, Cancel) {
+  TimerWheel wheel;
+  int fired = 0;
+  TimerId first = wheel.schedule_at(10, [&fired] { ++fired; });
+  TimerId second = wheel.schedule_at(10, [&fired] { fired += 10; });
+  EXPECT_TRUE(wheel.cancel(first));
+  EXPECT_FALSE(wheel.cancel(first));
+  EXPECT_FALSE(wheel.cancel(TimerId{}));
+
+  // 同じ位置が再利用されても古い識別子では取り消せない
+  TimerId third = wheel.schedule_at(10, [&fired] { fired += 100; });
+  EXPECT_EQ(third.m_index, first.m_index);
+  EXPECT_FALSE(wheel.cancel(first));
+
+  EXPECT_EQ(wheel.advance_to(10), 2u);
+  EXPECT_EQ(fired, 110);
+  EXPECT_FALSE(wheel.cancel(second));
+  EXPECT_TRUE(wheel.empty());
+}
+
+// 遠い期限が段を移りながら正しいティックで発火するかテスト
+TEST(TimerWheelTest, Cascade) {
+  TimerWheel wheel;
+  std::vector<std::uint64_t> ticks = {63,
+                                      64,
+                                      4095,
+                                      4096,
+                                      4097,
+                                      std::uint64_t{1} << 20,
+                                      (std::uint64_t{1} << 20) + 1,
+                                      std::uint64_t{1} << 40,
+                                      (std::uint64_t{1} << 40) + 12345};
+  std::vector<std::uint64_t> fired;
+  for (auto tick : ticks) {
+    wheel.schedule_at(tick, [&fired, &wheel] {
+      fired.push_back(wheel.current_tick() - 1);
+    });
+  }
+  for (auto tick : ticks) {
+    EXPECT_EQ(wheel.advance_to(tick - 1), 0u) << tick;
+    EXPECT_EQ(wheel.advance_to(tick), 1u) << tick;
+  }
+  EXPECT_EQ(fired, ticks);
+}
+
+// コールバック内での登録と取り消しをテスト
+TEST(TimerWheelTest, ReentrantCallbacks) {
+  TimerWheel wheel;
+  std::vector<int> fired;
+  TimerId victim = wheel.schedule_at(5, [&fired] { fired.push_back(-1); });
+  wheel.schedule_at(5, [&] {
+    fired.push_back(5);
+    wheel.cancel(victim);
+    // 同じティックを指定しても次のティックで発火する
+    wheel.schedule_at(5, [&fired] { fired.push_back(6); });
+    // ノードの再確保が起きても発火中のコールバックは影響を受けない
+    for (int i = 0; i < 100; ++i) {
+      wheel.schedule_at(1000, [] {});
+    }
+  });
+  EXPECT_EQ(wheel.advance_to(5), 1u);
+  EXPECT_EQ(fired, (std::vector<int>{5}));
+  EXPECT_EQ(wheel.advance_to(6), 1u);
+  EXPECT_EQ(fired, (std::vector<int>{5, 6}));
+  EXPECT_EQ(wheel.size(), 100u);
+}
+
+// ランダムな期限とキャンセルを整列済みの期待値と比較
+TEST(TimerWheelTest, RandomAgainstSorted) {
+  TimerWheel wheel;
+  std::vector<std::pair<std::uint64_t, int>> expected;
+  std::vector<std::pair<std::uint64_t, int>> fired;
+  std::uint32_t x = 12345;
+  for (int i = 0; i < 5000; ++i) {
+    x = x * 1664525u + 1013904223u;
+    std::uint64_t tick = x >> (x % 20);
+    TimerId id = wheel.schedule_at(tick, [&fired, &wheel, i] {
+      fired.emplace_back(wheel.current_tick() - 1, i);
+    });
+    if (i % 3 == 0) {
+      wheel.cancel(id);
+    } else {
+      expected.emplace_back(tick, i);
+    }
+  }
+  std::uint64_t now = 0;
+  while (!wheel.empty()) {
+    // 間隔を広げながら進め、空白を読み飛ばす経路も通す
+    now = now + now / 4 + 997;
+    wheel.advance_to(now);
+  }
+  // 同じティック内の順序は規定しない
+  std::sort(fired.begin(), fired.end());
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(fired, expected);
+}
+
+// 期限と時刻の変換をテスト
+TEST(TimerWheelTest, Deadlines) {
+  auto start = Deadline::Clock::now();
+  TimerWheel wheel(10ms, start);
+  EXPECT_EQ(wheel.next_deadline(), Deadline::never());
+
+  EXPECT_EQ(wheel.tick_of(Deadline(start + 15ms)), 2u);
+  EXPECT_EQ(wheel.tick_of(Deadline(start + 20ms)), 2u);
+  EXPECT_EQ(wheel.tick_at(start + 29ms), 2u);
+
+  bool fired = false;
+  wheel.schedule(Deadline(start + 25ms), [&fired] { fired = true; });
+  EXPECT_EQ(wheel.next_deadline(), Deadline(start + 30ms));
+  EXPECT_EQ(wheel.poll(start + 29ms), 0u);
+  EXPECT_FALSE(fired);
+  EXPECT_EQ(wheel.poll(start + 30ms), 1u);
+  EXPECT_TRUE(fired);
+
+  // 上の段のタイマーは段を移す時刻を返す
+  wheel.schedule_at(1000, [] {});
+  EXPECT_EQ(wheel.next_deadline(), Deadline(start + 9600ms));
+  wheel.schedule(Deadline::never(), [] {});
+  EXPECT_EQ(wheel.size(), 2u);
+}
+
+}  // namespace